@@ -0,0 +1,425 @@
+// bench/Bench.cpp
+//
+// Microbenchmarks for the engine hot paths. Build with `make -f MakeFile bench`.
+//
+//   tanks_bench [--quick] [--filter S] [--out results.json]
+//               [--baseline old.json] [--threshold PCT]
+//
+// Every case runs until it has used at least --min-ms of wall time and
+// reports nanoseconds per operation. With --baseline, cases are matched by
+// id and any case slower than the baseline by more than --threshold percent
+// (default 10) is listed as a regression; the exit code is then 1.
+
+#include "AggressiveTank.h"
+#include "Board.h"
+#include "EvasiveTank.h"
+#include "GameManager.h"
+#include "GameState.h"
+#include "MyBattleInfo.h"
+#include "MyPlayerFactory.h"
+#include "MyTankAlgorithmFactory.h"
+#include "PhaseTimes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+using namespace arena;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+//------------------------------------------------------------------------------
+// Scenarios
+//------------------------------------------------------------------------------
+struct Scenario {
+    std::size_t rows, cols;
+    std::size_t tanksPerPlayer;
+    double      shellDensity;   // shells per empty cell
+};
+
+constexpr double      WALL_DENSITY = 0.10;
+constexpr double      MINE_DENSITY = 0.02;
+constexpr std::size_t MAX_STEPS    = 1000000;
+constexpr std::size_t NUM_SHELLS   = 16;
+constexpr unsigned    SEED         = 12345;
+
+/// Deterministic random board: walls and mines first, then tanks on free cells.
+Board makeBoard(const Scenario& sc) {
+    std::mt19937 rng(SEED + unsigned(sc.rows * 31 + sc.cols));
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    Board board(sc.rows, sc.cols);
+    for (std::size_t y = 0; y < sc.rows; ++y)
+        for (std::size_t x = 0; x < sc.cols; ++x) {
+            double r = u(rng);
+            if (r < WALL_DENSITY)                     board.setCell(int(x), int(y), CellContent::WALL);
+            else if (r < WALL_DENSITY + MINE_DENSITY) board.setCell(int(x), int(y), CellContent::MINE);
+        }
+    std::uniform_int_distribution<std::size_t> px(0, sc.cols - 1), py(0, sc.rows - 1);
+    for (int player = 1; player <= 2; ++player) {
+        for (std::size_t placed = 0; placed < sc.tanksPerPlayer;) {
+            int x = int(px(rng)), y = int(py(rng));
+            if (board.getCell(x, y).content() != CellContent::EMPTY) continue;
+            board.setCell(x, y, player == 1 ? CellContent::TANK1 : CellContent::TANK2);
+            ++placed;
+        }
+    }
+    return board;
+}
+
+void spawnShells(GameState& gs, const Board& board, double density) {
+    if (density <= 0) return;
+    std::mt19937 rng(SEED);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::uniform_int_distribution<int> dir(0, 7);
+    for (std::size_t y = 0; y < board.getRows(); ++y)
+        for (std::size_t x = 0; x < board.getCols(); ++x)
+            if (board.getCell(int(x), int(y)).content() == CellContent::EMPTY && u(rng) < density)
+                gs.spawnShell(int(x), int(y), dir(rng));
+}
+
+void writeMapFile(const Board& board, const std::string& path) {
+    std::ofstream out(path);
+    out << "bench\nMaxSteps = " << MAX_STEPS << "\nNumShells = " << NUM_SHELLS
+        << "\nRows = " << board.getRows() << "\nCols = " << board.getCols() << "\n";
+    std::string line(board.getCols(), '.');
+    for (std::size_t y = 0; y < board.getRows(); ++y) {
+        const Cell* row = board.row(y);
+        for (std::size_t x = 0; x < board.getCols(); ++x) {
+            switch (row[x].content()) {
+                case CellContent::WALL:  line[x] = '#'; break;
+                case CellContent::MINE:  line[x] = '@'; break;
+                case CellContent::TANK1: line[x] = '1'; break;
+                case CellContent::TANK2: line[x] = '2'; break;
+                default:                 line[x] = '.'; break;
+            }
+        }
+        out << line << '\n';
+    }
+}
+
+std::unique_ptr<GameState> newGame(const Board& board, double shellDensity,
+                                   bool shellPlanes = false) {
+    auto gs = std::make_unique<GameState>(std::make_unique<MyPlayerFactory>(),
+                                          std::make_unique<common::MyTankAlgorithmFactory>());
+    gs->initialize(board, MAX_STEPS, NUM_SHELLS);
+    gs->setShellPlanes(shellPlanes);
+    spawnShells(*gs, board, shellDensity);
+    return gs;
+}
+
+/// Position of the first tank of `player` on the board.
+void findTank(const Board& board, CellContent tank, std::size_t& x, std::size_t& y) {
+    for (y = 0; y < board.getRows(); ++y)
+        for (x = 0; x < board.getCols(); ++x)
+            if (board.getCell(int(x), int(y)).content() == tank) return;
+    x = y = 0;
+}
+
+//------------------------------------------------------------------------------
+// Measurement
+//------------------------------------------------------------------------------
+struct Result {
+    std::string id;
+    std::string name;
+    Scenario    sc;
+    std::uint64_t iterations = 0;
+    double      nsPerOp = 0;
+    bool        hasPhases = false;
+    double      phaseNs[TURN_PHASE_COUNT]{};
+};
+
+/// Swallows std::cerr while algorithms run (AggressiveTank logs every call)
+/// and the boards the render case prints.
+struct NullBuffer : std::streambuf {
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+double minMillis = 200;
+
+std::string caseId(const std::string& name, const Scenario& sc, bool withEntities) {
+    std::ostringstream id;
+    id << name << '/' << sc.rows << 'x' << sc.cols;
+    if (withEntities) id << "/t" << sc.tanksPerPlayer << "/s" << sc.shellDensity;
+    return id.str();
+}
+
+/// Calls op() once untimed (first-call allocations), then in growing
+/// batches until minMillis have passed.
+template <typename Op>
+void measure(Result& r, Op&& op) {
+    op();
+    std::uint64_t batch = 1, total = 0;
+    Clock::duration spent{};
+    while (std::chrono::duration<double, std::milli>(spent).count() < minMillis) {
+        auto start = Clock::now();
+        for (std::uint64_t i = 0; i < batch; ++i) op();
+        spent += Clock::now() - start;
+        total += batch;
+        if (batch < (1u << 20)) batch *= 2;
+    }
+    r.iterations = total;
+    r.nsPerOp    = std::chrono::duration<double, std::nano>(spent).count() / double(total);
+}
+
+Result benchReadBoard(const Scenario& sc, const Board& board) {
+    Result r{caseId("read_board", sc, false), "read_board", sc};
+    const std::string path = "bench_map_tmp.txt";
+    writeMapFile(board, path);
+    GameManager gm(std::make_unique<MyPlayerFactory>(),
+                   std::make_unique<common::MyTankAlgorithmFactory>());
+    std::string error;
+    measure(r, [&] { gm.readBoard(path, error); });
+    std::remove(path.c_str());
+    return r;
+}
+
+Result benchSnapshot(const Scenario& sc, const Board& board) {
+    Result r{caseId("snapshot", sc, false), "snapshot", sc};
+    auto gs = newGame(board, 0);
+    measure(r, [&] { auto snap = gs->buildBattleSnapshot(); (void)snap; });
+    return r;
+}
+
+/// One op = one printBoard() of a board with tanks and shells (output dropped).
+Result benchRender(const Scenario& sc, const Board& board) {
+    Result r{caseId("render", sc, true), "render", sc};
+    auto gs = newGame(board, sc.shellDensity);
+    gs->playOneTurn();   // shells get their overlay at the end of a turn
+    NullBuffer sink;
+    std::ostream os(&sink);
+    measure(r, [&] { gs->printBoard(os); });
+    return r;
+}
+
+/// One op = one turn. Games restart (untimed) every TURNS_PER_GAME turns or
+/// when they end, so the board keeps its density. "turn_planes" is the same
+/// with GameState::setShellPlanes on.
+Result benchTurn(const Scenario& sc, const Board& board, bool shellPlanes = false) {
+    constexpr std::size_t TURNS_PER_GAME = 20;
+    const std::string name = shellPlanes ? "turn_planes" : "turn";
+    Result r{caseId(name, sc, true), name, sc};
+    PhaseTimes phases;
+    Clock::duration spent{};
+    std::uint64_t turns = 0;
+    while (std::chrono::duration<double, std::milli>(spent).count() < minMillis) {
+        auto gs = newGame(board, sc.shellDensity, shellPlanes);
+        gs->setPhaseTimes(&phases);
+        auto start = Clock::now();
+        for (std::size_t t = 0; t < TURNS_PER_GAME && !gs->isGameOver(); ++t, ++turns)
+            gs->playOneTurn();
+        spent += Clock::now() - start;
+    }
+    r.iterations = turns;
+    r.nsPerOp    = std::chrono::duration<double, std::nano>(spent).count() / double(turns);
+    r.hasPhases  = phases.turns > 0;   // false when built with ARENA_PROFILE=0
+    for (std::size_t p = 0; r.hasPhases && p < TURN_PHASE_COUNT; ++p)
+        r.phaseNs[p] = double(phases.phase[p].total) / double(phases.turns);
+    return r;
+}
+
+/// One op = a battle info for a tank that has none yet, then getAction(),
+/// which plans from scratch. Every op gets its own tank, built untimed, so
+/// no op inherits a plan, a shooting cooldown or spent shells from the last.
+///
+/// The picture is drawn the way the search reads it: '.' open ground, walls
+/// and tanks. Engine views draw open ground as ' ', and the search treats
+/// every cell other than '.' and '#' as something to shoot at, mines too,
+/// so on those it ends within a cell or two whatever the board size.
+Result benchAggressivePlan(const Scenario& sc, const Board& board) {
+    constexpr std::size_t TANKS_PER_BATCH = 64;
+    Result r{caseId("aggressive_plan", sc, true), "aggressive_plan", sc};
+    auto gs = newGame(board, 0);
+    MyBattleInfo info(board.getRows(), board.getCols());
+    auto picture = std::make_shared<BattleSnapshot>(*gs->buildBattleSnapshot());
+    std::replace(picture->cells.begin(), picture->cells.end(), ' ', '.');
+    std::replace(picture->cells.begin(), picture->cells.end(), '@', '.');
+    picture->hash = zobrist::pictureHash(picture->cells.data(), picture->cells.size());
+    info.snapshot = picture;
+    findTank(board, CellContent::TANK1, info.selfX, info.selfY);
+    info.shellsRemaining = NUM_SHELLS;
+
+    std::vector<std::unique_ptr<AggressiveTank>> tanks;
+    std::vector<MyBattleInfo> infos;
+    auto batch = [&] {
+        tanks.clear();
+        infos.assign(TANKS_PER_BATCH, info);
+        for (std::size_t i = 0; i < TANKS_PER_BATCH; ++i)
+            tanks.push_back(std::make_unique<AggressiveTank>(1, 0));
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < TANKS_PER_BATCH; ++i) {
+            tanks[i]->updateBattleInfo(infos[i]);
+            (void)tanks[i]->getAction();
+        }
+        return Clock::now() - start;
+    };
+    batch();   // first-call allocations
+    Clock::duration spent{};
+    std::uint64_t ops = 0;
+    while (std::chrono::duration<double, std::milli>(spent).count() < minMillis) {
+        spent += batch();
+        ops   += TANKS_PER_BATCH;
+    }
+    r.iterations = ops;
+    r.nsPerOp    = std::chrono::duration<double, std::nano>(spent).count() / double(ops);
+    return r;
+}
+
+/// One op = one getAction(); EvasiveTank alternates view requests and moves.
+Result benchEvasiveAction(const Scenario& sc, const Board& board) {
+    Result r{caseId("evasive_action", sc, true), "evasive_action", sc};
+    auto gs = newGame(board, 0);
+    MyBattleInfo info(board.getRows(), board.getCols());
+    info.snapshot = gs->buildBattleSnapshot();
+    findTank(board, CellContent::TANK2, info.selfX, info.selfY);
+    info.shellsRemaining = NUM_SHELLS;
+    EvasiveTank tank(2, 0);
+    tank.updateBattleInfo(info);
+    measure(r, [&] { (void)tank.getAction(); });
+    return r;
+}
+
+//------------------------------------------------------------------------------
+// JSON in and out. One result per line so a baseline can be read back
+// without a JSON library.
+//------------------------------------------------------------------------------
+void writeJson(std::ostream& os, const std::vector<Result>& results) {
+    os << "{\n  \"version\": 1,\n  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        os << "    {\"id\": \"" << r.id << "\", \"name\": \"" << r.name
+           << "\", \"rows\": " << r.sc.rows << ", \"cols\": " << r.sc.cols
+           << ", \"tanks_per_player\": " << r.sc.tanksPerPlayer
+           << ", \"shell_density\": " << r.sc.shellDensity
+           << ", \"iterations\": " << r.iterations
+           << ", \"ns_per_op\": " << r.nsPerOp;
+        if (r.hasPhases) {
+            os << ", \"phase_ns\": {";
+            for (std::size_t p = 0; p < TURN_PHASE_COUNT; ++p)
+                os << (p ? ", " : "") << '"' << phaseName(TurnPhase(p)) << "\": " << r.phaseNs[p];
+            os << '}';
+        }
+        os << '}' << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+    os << "  ]\n}\n";
+}
+
+bool readBaseline(const std::string& path, std::map<std::string, double>& out) {
+    std::ifstream in(path);
+    if (!in) return false;
+    const std::string idKey = "\"id\": \"", nsKey = "\"ns_per_op\": ";
+    std::string line;
+    while (std::getline(in, line)) {
+        auto a = line.find(idKey), b = line.find(nsKey);
+        if (a == std::string::npos || b == std::string::npos) continue;
+        a += idKey.size();
+        std::string id = line.substr(a, line.find('"', a) - a);
+        out[id] = std::stod(line.substr(b + nsKey.size()));
+    }
+    return true;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv) {
+    bool quick = false;
+    double threshold = 10;
+    std::string filter, outFile, baselineFile;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick")                          quick = true;
+        else if (arg == "--filter" && i + 1 < argc)    filter = argv[++i];
+        else if (arg == "--out" && i + 1 < argc)       outFile = argv[++i];
+        else if (arg == "--baseline" && i + 1 < argc)  baselineFile = argv[++i];
+        else if (arg == "--threshold" && i + 1 < argc) threshold = std::stod(argv[++i]);
+        else if (arg == "--min-ms" && i + 1 < argc)    minMillis = std::stod(argv[++i]);
+        else {
+            std::cerr << "Usage: tanks_bench [--quick] [--filter S] [--out results.json]\n"
+                      << "                   [--baseline old.json] [--threshold PCT] [--min-ms MS]\n";
+            return 1;
+        }
+    }
+    if (quick) minMillis = std::min(minMillis, 20.0);
+
+    std::vector<std::size_t> sizes   = quick ? std::vector<std::size_t>{32, 128}
+                                             : std::vector<std::size_t>{32, 128, 512, 1024};
+    std::vector<std::size_t> tanks   = quick ? std::vector<std::size_t>{1, 8}
+                                             : std::vector<std::size_t>{1, 8, 32};
+    std::vector<double>      shells  = {0.0, 0.02, 0.25};
+
+    NullBuffer nullBuf;
+    std::streambuf* savedErr = std::cerr.rdbuf(&nullBuf);
+
+    std::vector<Result> results;
+    auto want = [&](const std::string& name) {
+        return filter.empty() || name.find(filter) != std::string::npos;
+    };
+    auto add = [&](Result r) {
+        std::fprintf(stderr, "%-36s %12.0f ns/op\n", r.id.c_str(), r.nsPerOp);
+        results.push_back(std::move(r));
+    };
+    for (std::size_t n : sizes) {
+        Scenario base{n, n, 8, 0.0};
+        Board board = makeBoard(base);
+        if (want("read_board")) add(benchReadBoard(base, board));
+        if (want("snapshot"))   add(benchSnapshot(base, board));
+        for (std::size_t t : tanks) {
+            Scenario sc{n, n, t, 0.0};
+            Board tb = makeBoard(sc);
+            if (want("aggressive_plan")) add(benchAggressivePlan(sc, tb));
+            if (want("evasive_action"))  add(benchEvasiveAction(sc, tb));
+            for (double s : shells) {
+                sc.shellDensity = s;
+                if (want("turn")) add(benchTurn(sc, tb));
+                if (s > 0 && want("turn_planes")) add(benchTurn(sc, tb, true));
+            }
+            if (t == tanks.back() && want("render")) {
+                sc.shellDensity = shells.back();
+                add(benchRender(sc, tb));
+            }
+        }
+    }
+    std::cerr.rdbuf(savedErr);
+
+    if (outFile.empty()) {
+        writeJson(std::cout, results);
+    } else {
+        std::ofstream out(outFile);
+        writeJson(out, results);
+        if (!out) {
+            std::cerr << "Cannot write " << outFile << "\n";
+            return 1;
+        }
+    }
+
+    if (baselineFile.empty()) return 0;
+    std::map<std::string, double> baseline;
+    if (!readBaseline(baselineFile, baseline)) {
+        std::cerr << "Cannot read baseline " << baselineFile << "\n";
+        return 1;
+    }
+    int regressions = 0;
+    std::fprintf(stderr, "\n%-36s %12s %12s %8s\n", "case", "baseline", "now", "change");
+    for (const Result& r : results) {
+        auto it = baseline.find(r.id);
+        if (it == baseline.end() || it->second <= 0) continue;
+        double change = (r.nsPerOp / it->second - 1.0) * 100.0;
+        bool   worse  = change > threshold;
+        regressions += worse;
+        std::fprintf(stderr, "%-36s %12.0f %12.0f %+7.1f%%%s\n", r.id.c_str(),
+                     it->second, r.nsPerOp, change, worse ? "  REGRESSION" : "");
+    }
+    return regressions ? 1 : 0;
+}
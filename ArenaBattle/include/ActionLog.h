@@ -0,0 +1,57 @@
+// include/ActionLog.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "common/ActionRequest.h"
+
+namespace arena {
+
+/// One tank's outcome for a turn, packed into a byte:
+///   bits 0-3 ActionRequest as requested, bit 4 ignored, bit 5 killed/dead.
+using TankOutcome = std::uint8_t;
+
+constexpr TankOutcome OUTCOME_IGNORED = 0x10;
+constexpr TankOutcome OUTCOME_KILLED  = 0x20;
+
+/// Packs a tank's turn. `ignored` is only kept where the text log shows it.
+inline TankOutcome makeOutcome(common::ActionRequest req, bool ignored, bool alive) {
+    TankOutcome o = TankOutcome(req);
+    if (!alive) return TankOutcome(o | OUTCOME_KILLED);
+    if (ignored && req != common::ActionRequest::GetBattleInfo) o |= OUTCOME_IGNORED;
+    return o;
+}
+
+inline common::ActionRequest outcomeAction(TankOutcome o) {
+    return common::ActionRequest(o & 0x0F);
+}
+
+/// Appends one turn's log line (no newline), e.g.
+/// "MoveForward, Shoot (ignored), killed".
+void appendTurnLine(std::string& out, const std::vector<TankOutcome>& outcomes);
+
+/// Destination for the per-turn action log written by GameManager::run().
+class ActionLog {
+public:
+    virtual ~ActionLog() = default;
+    virtual void writeTurn(const std::vector<TankOutcome>& outcomes) = 0;
+    virtual void writeResult(const std::string& result) = 0;
+};
+
+/// The plain-text output_<map>.txt format.
+class TextActionLog : public ActionLog {
+public:
+    explicit TextActionLog(std::ostream& out) : out_(out) {}
+    void writeTurn(const std::vector<TankOutcome>& outcomes) override;
+    void writeResult(const std::string& result) override;
+
+private:
+    std::ostream& out_;
+    std::string   line_;   // reused between turns
+};
+
+} // namespace arena
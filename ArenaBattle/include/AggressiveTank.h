@@ -3,17 +3,29 @@
 
 #include "common/TankAlgorithm.h"
 #include "MyBattleInfo.h"
+#include "Checkpoint.h"
+#include "DeltaViewer.h"
+#include "StateHash.h"
 #include "common/ActionRequest.h"
 #include <deque>
+#include <vector>
 
 namespace arena {
 
-class AggressiveTank : public common::TankAlgorithm {
+class AggressiveTank : public common::TankAlgorithm, public Checkpointable, public DeltaViewer,
+                       public StateHashable {
 public:
-    AggressiveTank(int playerIndex, int /*tankIndex*/);
+    /// With incrementalReplan, a fresh view keeps the current plan when the
+    /// cells it depends on still allow it (see planStillValid) instead of
+    /// always replanning from scratch.
+    AggressiveTank(int playerIndex, int /*tankIndex*/, bool incrementalReplan = false);
     void updateBattleInfo(common::BattleInfo& info) override;
     common::ActionRequest getAction() override;
 
+    void saveState(CheckpointWriter& out) const override;
+    bool loadState(CheckpointReader& in) override;
+    std::uint64_t stateHash() const override;
+
 private:
     MyBattleInfo                            lastInfo_;
     int                                     shellsLeft_{-1};
@@ -24,12 +36,17 @@ private:
     static constexpr int                    REFRESH_INTERVAL = 5;
 
     int                                     curX_{0}, curY_{0}, curDir_{0};
+    char                                    ownTank_;   // our player's char in views
+    bool                                    incrementalReplan_{false};
 
     static constexpr int                    ROTATE_COST = 1;
     static constexpr int                    MOVE_COST   = 1;
     static constexpr int                    SHOOT_CD    = 4;
 
     void computePlan();
+    void planFromFlow();
+    void appendPlan(const std::vector<common::ActionRequest>& seq, int x, int y, int dir);
+    bool planStillValid();
     bool lineOfSight(int startX, int startY, int dir, int& distSteps, int& wallsHit) const;
     bool isTraversable(int x, int y) const;
 };
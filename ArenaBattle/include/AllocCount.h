@@ -0,0 +1,28 @@
+// include/AllocCount.h
+#pragma once
+
+#include <cstdint>
+
+// Heap-allocation counting for checking that turns run allocation-free.
+// Build with -DARENA_COUNT_ALLOCS=1 (make ALLOC_COUNT=1) to replace the
+// global operator new with one that counts per thread; GameState then
+// asserts that the engine phases of a warmed-up turn allocate nothing.
+// Off by default: allocationCount() is always 0.
+#ifndef ARENA_COUNT_ALLOCS
+#define ARENA_COUNT_ALLOCS 0
+#endif
+
+namespace arena {
+
+#if ARENA_COUNT_ALLOCS
+
+/// Heap allocations made so far by the calling thread.
+std::uint64_t allocationCount();
+
+#else
+
+inline std::uint64_t allocationCount() { return 0; }
+
+#endif
+
+} // namespace arena
@@ -0,0 +1,51 @@
+// include/BatchRunner.h
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "GameManager.h"
+
+namespace arena {
+
+/// Outcome of one game in a batch.
+struct BatchResult {
+    std::string map_file;
+    bool        ok = false;
+    std::string result;        // game result line, or the error
+    std::size_t turns = 0;
+    double      millis = 0.0;  // load + play wall time
+};
+
+/// Runs many maps headless and concurrently, one GameManager per game, each
+/// writing its own output_<map> log like a single run would.
+class BatchRunner {
+public:
+    /// threads == 0 → one per hardware thread. With stopCycles, games end
+    /// once their state repeats (GameState::setCycleDetection).
+    explicit BatchRunner(std::size_t threads = 0, LogFormat format = LogFormat::Text,
+                         bool stopCycles = false);
+
+    /// Expands directories into their *.txt maps (sorted), skipping
+    /// output_*.txt action logs, and keeps files as is.
+    static std::vector<std::string> collectMaps(const std::vector<std::string>& paths);
+
+    /// Plays every map; results come back in input order. A map whose
+    /// output_<name> log would clash with an earlier map's (same file name
+    /// in another directory) is not played and reported as failed.
+    std::vector<BatchResult> run(const std::vector<std::string>& maps) const;
+
+    /// Per-map lines followed by totals and timings.
+    static void printSummary(std::ostream& out,
+                             const std::vector<BatchResult>& results,
+                             double wallMillis);
+
+private:
+    std::size_t threads_;
+    LogFormat   format_;
+    bool        stopCycles_;
+};
+
+} // namespace arena
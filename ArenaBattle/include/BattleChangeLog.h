@@ -0,0 +1,71 @@
+// include/BattleChangeLog.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "BattleSnapshot.h"
+
+namespace arena {
+
+/// One cell of a delta view: flat index (y*cols+x) and its new character.
+struct CellChange {
+    std::uint32_t cell;
+    char          c;
+};
+
+/// The engine's live satellite picture plus a log of the cells that changed,
+/// so GetBattleInfo can hand out a shared snapshot without rebuilding it from
+/// the board and DeltaViewer tanks can get only what changed since their last
+/// view (see DeltaViewer.h).
+///
+/// Versions count logged changes: a view taken at version v has seen every
+/// change before v. The log holds at most one board's worth of entries.
+class BattleChangeLog {
+public:
+    static constexpr std::uint64_t NO_VIEW = UINT64_MAX;
+
+    /// Starts over from `picture` and forgets all earlier versions.
+    void reset(const BattleSnapshot& picture);
+
+    /// Records the current character of a cell; no-op if it did not change.
+    void set(std::size_t cell, char c) {
+        if (cells_[cell] == c) return;
+        hash_ ^= zobrist::cellKey(cell, cells_[cell]) ^ zobrist::cellKey(cell, c);
+        cells_[cell] = c;
+        if (log_.size() >= cells_.size()) {
+            base_ += log_.size();
+            log_.clear();
+        }
+        log_.push_back(std::uint32_t(cell));
+    }
+
+    std::uint64_t version() const { return base_ + log_.size(); }
+
+    /// zobrist::pictureHash() of the live picture, kept up to date by set().
+    std::uint64_t pictureHash() const { return hash_; }
+
+    /// Shared snapshot of the current picture. Patched in place when nobody
+    /// else holds the previous one, copied from the live picture otherwise.
+    SnapshotPtr snapshot();
+
+    /// Appends the cells changed since version `since` (with their current
+    /// characters; a cell may appear more than once) to out. Returns false
+    /// if a full view is the better deal: `since` is NO_VIEW, older than
+    /// the log, or more than an eighth of the board has been logged since
+    /// (patching costs more per cell than one copy of the grid).
+    bool changesSince(std::uint64_t since, std::vector<CellChange>& out) const;
+
+private:
+    std::size_t                     rows_ = 0, cols_ = 0;
+    std::vector<char>               cells_;     // live picture, row-major
+    std::vector<std::uint32_t>      log_;       // changed cell per version
+    std::uint64_t                   base_ = 0;  // version of log_[0]
+    std::uint64_t                   hash_ = 0;  // of cells_
+    std::shared_ptr<BattleSnapshot> cached_;    // last snapshot() handed out
+    std::uint64_t                   cachedVersion_ = 0;
+};
+
+} // namespace arena
@@ -0,0 +1,36 @@
+// include/BattleSnapshot.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "StateHash.h"
+
+namespace arena {
+
+/// Immutable satellite picture of the battlefield for one turn.
+/// cells is row-major (y*cols+x) with the SatelliteView characters; it never
+/// carries a '%' marker, which is per-requester and added by the view.
+/// GameState builds one per turn and shares it with every requester.
+struct BattleSnapshot {
+    std::size_t       rows = 0, cols = 0;
+    std::vector<char> cells;
+    /// Distinct for every picture the engine's change log hands out (a
+    /// snapshot it patches in place gets a new one); 0 = not versioned.
+    std::uint64_t     version = 0;
+    /// zobrist::pictureHash() of cells; whoever writes cells keeps it
+    /// current (see StateHash.h).
+    std::uint64_t     hash = 0;
+
+    BattleSnapshot(std::size_t r, std::size_t c, char fill = ' ')
+      : rows(r), cols(c), cells(r * c, fill),
+        hash(fill == ' ' ? 0 : zobrist::pictureHash(cells.data(), cells.size())) {}
+
+    char at(std::size_t x, std::size_t y) const { return cells[y * cols + x]; }
+};
+
+using SnapshotPtr = std::shared_ptr<const BattleSnapshot>;
+
+} // namespace arena
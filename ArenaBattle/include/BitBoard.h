@@ -0,0 +1,37 @@
+// include/BitBoard.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arena {
+
+/// One bit per board cell, keyed by flat cell index (y*cols+x) and packed
+/// into 64-bit words, so a layer costs an eighth of the Board. Layers that
+/// only get a few bits per turn are cleared bit by bit by whoever set them,
+/// never wholesale, so a turn stays O(entities) on any board size.
+class BitBoard {
+public:
+    /// Sizes the layer for `cells` cells, all clear.
+    void reset(std::size_t cells) { words_.assign((cells + 63) / 64, 0); }
+
+    bool test(std::size_t cell) const { return (words_[cell >> 6] & bit(cell)) != 0; }
+    void set(std::size_t cell)        { words_[cell >> 6] |= bit(cell); }
+    void clear(std::size_t cell)      { words_[cell >> 6] &= ~bit(cell); }
+
+    /// Sets the bit and returns whether it was set already.
+    bool testAndSet(std::size_t cell) {
+        std::uint64_t& w = words_[cell >> 6];
+        const bool was = (w & bit(cell)) != 0;
+        w |= bit(cell);
+        return was;
+    }
+
+private:
+    static std::uint64_t bit(std::size_t cell) { return std::uint64_t(1) << (cell & 63); }
+
+    std::vector<std::uint64_t> words_;
+};
+
+} // namespace arena
@@ -0,0 +1,88 @@
+// include/BitPlane.h
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arena {
+
+/// One bit per cell of a torus board, laid out row by row with every row
+/// padded to whole 64-bit words (padding bits stay clear). Unlike BitBoard
+/// it is meant to be processed whole: shiftFrom() moves every bit one cell
+/// in one pass of word shifts, and words() exposes the storage for
+/// and/or/andnot loops over several planes of the same size.
+class BitPlane {
+public:
+    /// Sizes the plane for rows × cols cells, all clear.
+    void reset(std::size_t rows, std::size_t cols) {
+        rows_     = rows;
+        cols_     = cols;
+        rowWords_ = (cols + 63) / 64;
+        lastMask_ = cols % 64 ? (std::uint64_t(1) << (cols % 64)) - 1 : ~std::uint64_t(0);
+        words_.assign(rows * rowWords_, 0);
+    }
+
+    void clearAll() { std::fill(words_.begin(), words_.end(), 0); }
+
+    bool test(int x, int y) const { return (words_[word(x, y)] & bit(x)) != 0; }
+    void set(int x, int y)        { words_[word(x, y)] |= bit(x); }
+    void clear(int x, int y)      { words_[word(x, y)] &= ~bit(x); }
+
+    /// Sets the bit and returns whether it was set already.
+    bool testAndSet(int x, int y) {
+        std::uint64_t& w = words_[word(x, y)];
+        const bool was = (w & bit(x)) != 0;
+        w |= bit(x);
+        return was;
+    }
+
+    /// *this = src with every bit moved by (dx, dy), each in -1..1, wrapping
+    /// around both edges. src must have the same size and not be *this.
+    void shiftFrom(const BitPlane& src, int dx, int dy);
+
+    std::uint64_t*       words()           { return words_.data(); }
+    const std::uint64_t* words()     const { return words_.data(); }
+    std::size_t          wordCount() const { return words_.size(); }
+
+    void swap(BitPlane& other) { words_.swap(other.words_); }
+
+private:
+    std::size_t word(int x, int y) const {
+        return std::size_t(y) * rowWords_ + (std::size_t(x) >> 6);
+    }
+    static std::uint64_t bit(int x) { return std::uint64_t(1) << (x & 63); }
+
+    std::size_t rows_ = 0, cols_ = 0, rowWords_ = 0;
+    std::uint64_t lastMask_ = 0;     // valid bits of a row's last word
+    std::vector<std::uint64_t> words_;
+};
+
+inline void BitPlane::shiftFrom(const BitPlane& src, int dx, int dy) {
+    const std::size_t W = rowWords_;
+    const unsigned    top = unsigned((cols_ - 1) % 64);   // bit of the last column in its word
+    for (std::size_t y = 0; y < rows_; ++y) {
+        const std::size_t sy = (y + rows_ + 1 - std::size_t(dy + 1)) % rows_;   // y - dy
+        const std::uint64_t* in  = src.words_.data() + sy * W;
+        std::uint64_t*       out = words_.data() + y * W;
+        if (dx == 0) {
+            for (std::size_t w = 0; w < W; ++w) out[w] = in[w];
+        } else if (dx > 0) {
+            // x ← x - 1; column 0 gets the last column
+            std::uint64_t carry = (in[W - 1] >> top) & 1;
+            for (std::size_t w = 0; w < W; ++w) {
+                const std::uint64_t v = in[w];
+                out[w] = (v << 1) | carry;
+                carry  = v >> 63;
+            }
+            out[W - 1] &= lastMask_;
+        } else {
+            // x ← x + 1; the last column gets column 0
+            for (std::size_t w = 0; w + 1 < W; ++w) out[w] = (in[w] >> 1) | (in[w + 1] << 63);
+            out[W - 1] = (in[W - 1] >> 1) | ((in[0] & 1) << top);
+        }
+    }
+}
+
+} // namespace arena
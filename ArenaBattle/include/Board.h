@@ -3,9 +3,10 @@
 
 #include <vector>
 #include <cstddef>
+#include <cstdint>
 
 /// Contents of a single board cell.
-enum class CellContent {
+enum class CellContent : std::uint8_t {
     EMPTY,
     WALL,
     MINE,
@@ -13,14 +14,38 @@ enum class CellContent {
     TANK2
 };
 
-/// A cell tracks its content, wall-hit count, and any shell overlay.
+/// A cell packs its content, wall-hit count, and shell overlay into one byte:
+///   bits 0-2 content, bits 3-4 wall hits (saturating at 3), bit 5 shell overlay.
 struct Cell {
-    CellContent content = CellContent::EMPTY;
-    int         wallHits = 0;
-    bool        hasShellOverlay = false;
+    std::uint8_t bits = 0;
+
+    static constexpr std::uint8_t CONTENT_MASK = 0x07;
+    static constexpr std::uint8_t HITS_SHIFT   = 3;
+    static constexpr std::uint8_t HITS_MASK    = 0x18;
+    static constexpr std::uint8_t SHELL_BIT    = 0x20;
+
+    CellContent content()         const { return CellContent(bits & CONTENT_MASK); }
+    int         wallHits()        const { return (bits & HITS_MASK) >> HITS_SHIFT; }
+    bool        hasShellOverlay() const { return (bits & SHELL_BIT) != 0; }
+
+    /// Replaces the content, keeping wall hits and overlay untouched.
+    void setContent(CellContent c) {
+        bits = std::uint8_t((bits & ~CONTENT_MASK) | std::uint8_t(c));
+    }
+    /// Records one more wall hit and returns the new count.
+    int addWallHit() {
+        int h = wallHits();
+        if (h < 3) bits = std::uint8_t(bits + (1u << HITS_SHIFT));
+        return wallHits();
+    }
+    void setShellOverlay(bool on) {
+        bits = std::uint8_t(on ? (bits | SHELL_BIT) : (bits & ~SHELL_BIT));
+    }
 };
+static_assert(sizeof(Cell) == 1, "Cell must stay one byte");
 
 /// A toroidal grid of Cells supporting walls, mines, and tanks.
+/// Cells live in one row-major buffer: (x,y) is at index y*stride()+x.
 class Board {
 public:
     Board() = default;
@@ -31,24 +56,29 @@ public:
     int         getWidth()  const { return int(cols_); }
     int         getHeight() const { return int(rows_); }
 
-    const std::vector<std::vector<Cell>>& getGrid() const { return grid_; }
+    /// Distance between the starts of two consecutive rows in getCells().
+    std::size_t stride() const { return cols_; }
+    std::size_t index(int x, int y) const { return std::size_t(y) * cols_ + std::size_t(x); }
 
-    Cell&       getCell(int x, int y)       { return grid_[y][x]; }
-    const Cell& getCell(int x, int y) const { return grid_[y][x]; }
+    /// The whole board as one contiguous row-major buffer.
+    const std::vector<Cell>& getCells() const { return cells_; }
 
-    /// Sets content at (x,y), resetting wallHits if it becomes a wall.
+    Cell*       row(std::size_t y)       { return cells_.data() + y * cols_; }
+    const Cell* row(std::size_t y) const { return cells_.data() + y * cols_; }
+
+    Cell&       getCell(int x, int y)       { return cells_[index(x, y)]; }
+    const Cell& getCell(int x, int y) const { return cells_[index(x, y)]; }
+
+    /// Sets content at (x,y), resetting wall hits and shell overlay.
     void setCell(int x, int y, CellContent c);
 
     /// Wraps x,y into valid range [0..width) × [0..height).
     void wrapCoords(int& x, int& y) const;
 
-    /// Clears all shell overlays.
-    void clearShellMarks();
-
     /// No-op: tanks are tracked in CellContent, not via flags.
     void clearTankMarks() {}
 
 private:
     std::size_t rows_ = 0, cols_ = 0;
-    std::vector<std::vector<Cell>> grid_;
+    std::vector<Cell> cells_;
 };
@@ -0,0 +1,38 @@
+// include/CellChars.h
+#pragma once
+
+#include <cstddef>
+
+#include "Board.h"
+
+namespace arena {
+
+/// Characters for the 8 CellContent codes, plus the one an EMPTY cell
+/// with a shell overlay gets ('\0' = overlays ignored).
+struct CellCharTable {
+    char content[8];
+    char shell;
+};
+
+/// SatelliteView picture: ' ', '#', '@', '1', '2'; no shells.
+inline constexpr CellCharTable SATELLITE_CHARS{{' ', '#', '@', '1', '2', ' ', ' ', ' '}, '\0'};
+/// The same with shells shown as '*' (GameState::setShellsInViews).
+inline constexpr CellCharTable SATELLITE_SHELL_CHARS{{' ', '#', '@', '1', '2', ' ', ' ', ' '}, '*'};
+/// printBoard picture: '_' or '*' (shell) for empty cells, tanks as '1'/'2'.
+inline constexpr CellCharTable RENDER_CHARS{{'_', '#', '@', '1', '2', '_', '_', '_'}, '*'};
+
+inline char cellChar(Cell cell, const CellCharTable& t) {
+    if (t.shell && (cell.bits & (Cell::SHELL_BIT | Cell::CONTENT_MASK)) == Cell::SHELL_BIT)
+        return t.shell;
+    return t.content[cell.bits & Cell::CONTENT_MASK];
+}
+
+/// out[i] = cellChar(cells[i], t) for i < n. Uses AVX2 or SSE4.1 when the
+/// CPU has them (built with ARENA_SIMD=1, the default), 16/32 cells per
+/// table lookup with the shell overlay blended in by mask.
+void cellsToChars(const Cell* cells, std::size_t n, char* out, const CellCharTable& t);
+
+/// Which kernel cellsToChars() runs: "avx2", "sse4.1" or "scalar".
+const char* cellCharsKernel();
+
+} // namespace arena
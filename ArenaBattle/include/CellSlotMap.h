@@ -0,0 +1,108 @@
+// include/CellSlotMap.h
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arena {
+
+/// Open-addressing hash from a flat cell index (y*cols+x) to a 32-bit slot.
+/// Memory scales with the number of occupied cells, not with the board, so it
+/// suits sparse per-cell lookups (shells, tanks) on very large maps.
+class CellSlotMap {
+public:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    /// Drops every entry and sizes the table for about `expected` keys.
+    void clear(std::size_t expected = 0) {
+        std::size_t cap = 16;
+        while (cap < expected * 2) cap <<= 1;
+        if (cap != keys_.size()) {
+            keys_.assign(cap, NONE);
+            vals_.assign(cap, NONE);
+            shift_ = 32;
+            for (std::size_t c = cap; c > 1; c >>= 1) --shift_;
+        } else if (size_ > 0) {
+            std::fill(keys_.begin(), keys_.end(), NONE);
+        }
+        size_ = 0;
+    }
+
+    /// Keeps room for `expected` keys, so later clear() calls up to that
+    /// size reuse the storage instead of reallocating it.
+    void reserve(std::size_t expected) {
+        std::size_t cap = 16;
+        while (cap < expected * 2) cap <<= 1;
+        keys_.reserve(cap);
+        vals_.reserve(cap);
+    }
+
+    std::size_t size() const { return size_; }
+
+    /// Value stored for `cell`, or NONE.
+    std::uint32_t find(std::uint32_t cell) const {
+        if (keys_.empty()) return NONE;
+        for (std::size_t i = home(cell);; i = (i + 1) & mask()) {
+            if (keys_[i] == cell) return vals_[i];
+            if (keys_[i] == NONE) return NONE;
+        }
+    }
+
+    /// Value slot for `cell`, inserted as `init` if absent.
+    /// The reference is valid until the next insertion or erase.
+    std::uint32_t& slot(std::uint32_t cell, std::uint32_t init = NONE) {
+        if ((size_ + 1) * 2 > keys_.size()) grow();
+        std::size_t i = home(cell);
+        while (keys_[i] != NONE && keys_[i] != cell) i = (i + 1) & mask();
+        if (keys_[i] == NONE) {
+            keys_[i] = cell;
+            vals_[i] = init;
+            ++size_;
+        }
+        return vals_[i];
+    }
+
+    /// Removes `cell` if present (backward-shift deletion, no tombstones).
+    void erase(std::uint32_t cell) {
+        if (keys_.empty()) return;
+        std::size_t i = home(cell);
+        while (keys_[i] != cell) {
+            if (keys_[i] == NONE) return;
+            i = (i + 1) & mask();
+        }
+        for (std::size_t j = (i + 1) & mask(); keys_[j] != NONE; j = (j + 1) & mask()) {
+            std::size_t h = home(keys_[j]);
+            // move j back into the hole at i unless its home lies in (i, j]
+            if (((j - h) & mask()) >= ((j - i) & mask())) {
+                keys_[i] = keys_[j];
+                vals_[i] = vals_[j];
+                i = j;
+            }
+        }
+        keys_[i] = NONE;
+        --size_;
+    }
+
+private:
+    std::size_t mask() const { return keys_.size() - 1; }
+    std::size_t home(std::uint32_t cell) const {
+        return std::size_t((cell * 0x9E3779B1u) >> shift_);
+    }
+
+    void grow() {
+        std::vector<std::uint32_t> oldKeys, oldVals;
+        oldKeys.swap(keys_);
+        oldVals.swap(vals_);
+        clear(oldKeys.empty() ? 8 : oldKeys.size());
+        for (std::size_t i = 0; i < oldKeys.size(); ++i)
+            if (oldKeys[i] != NONE) slot(oldKeys[i]) = oldVals[i];
+    }
+
+    std::vector<std::uint32_t> keys_, vals_;
+    unsigned    shift_{28};
+    std::size_t size_{0};
+};
+
+} // namespace arena
@@ -0,0 +1,83 @@
+// include/Checkpoint.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BattleSnapshot.h"
+
+namespace arena {
+
+/*
+  Checkpoint file (see GameManager::saveCheckpoint):
+
+    "TKCP" varint version
+    string map_file
+    GameState section (board cells raw, tanks, shells, step counters,
+    players and tank algorithms that are Checkpointable, the cycle
+    detector's anchor)
+
+  Integers are LEB128 varints (signed ones zigzag-encoded). Battle snapshots
+  are written once and referenced by id afterwards, so tanks that share a
+  turn snapshot still share it after a restore.
+*/
+constexpr char          CHECKPOINT_MAGIC[4] = {'T', 'K', 'C', 'P'};
+constexpr std::uint64_t CHECKPOINT_VERSION  = 4;
+
+class CheckpointWriter {
+public:
+    void putU(std::uint64_t v);
+    void putI(std::int64_t v) { putU((std::uint64_t(v) << 1) ^ std::uint64_t(v >> 63)); }
+    void putBool(bool b)      { putU(b ? 1 : 0); }
+    void putBytes(const void* data, std::size_t n);
+    void putString(const std::string& s);
+    /// Null, a new snapshot, or a back-reference to one already written.
+    void putSnapshot(const SnapshotPtr& snap);
+
+    const std::vector<char>& data() const { return buf_; }
+
+private:
+    std::vector<char> buf_;
+    std::unordered_map<const BattleSnapshot*, std::uint64_t> snapIds_;
+};
+
+/// Reads what CheckpointWriter wrote. Errors are sticky: after the first
+/// short or malformed read every getter returns a zero value and ok() is false.
+class CheckpointReader {
+public:
+    CheckpointReader(const char* data, std::size_t size)
+      : cur_(data), end_(data + size) {}
+
+    std::uint64_t getU();
+    std::int64_t  getI() { std::uint64_t u = getU(); return std::int64_t(u >> 1) ^ -std::int64_t(u & 1); }
+    bool          getBool() { return getU() != 0; }
+    bool          getBytes(void* out, std::size_t n);
+    std::string   getString();
+    SnapshotPtr   getSnapshot();
+
+    bool ok()       const { return !failed_; }
+    bool atEnd()    const { return cur_ == end_; }
+    void fail()           { failed_ = true; }
+
+private:
+    const char* cur_;
+    const char* end_;
+    bool        failed_ = false;
+    std::vector<SnapshotPtr> snaps_;
+};
+
+/// Optional interface for TankAlgorithm and Player implementations whose
+/// state should survive a checkpoint. Those that do not implement it are
+/// restored freshly constructed from their factory.
+class Checkpointable {
+public:
+    virtual ~Checkpointable() = default;
+    virtual void saveState(CheckpointWriter& out) const = 0;
+    /// Returns false if the data does not fit this object.
+    virtual bool loadState(CheckpointReader& in) = 0;
+};
+
+} // namespace arena
@@ -0,0 +1,29 @@
+// include/ConcurrentPlayer.h
+#pragma once
+
+namespace arena {
+
+/*
+  Threading contract for the decision phase of GameState::advanceOneTurn
+  when decision threads are enabled:
+
+   - TankAlgorithm::getAction() runs for different tanks concurrently. Each
+     algorithm object is only used by one thread at a time, so it must not
+     share mutable state with other tanks without its own locking.
+   - Player::updateTankWithBattleInfo() is called after all getAction()
+     calls of the turn. For an ordinary common::Player the calls are made one
+     at a time, in tank order, exactly as in a single-threaded run.
+   - A Player that also derives from ConcurrentPlayer declares that its
+     updates for different tanks may run concurrently, with one exception:
+     its first update of a turn (the lowest tank index that asked) runs on
+     its own, before the others start. Anything the player does once, per
+     turn or per game, it can do there and get the same tank as in a serial
+     run. The other updates may run in any order and at the same time, so
+     they must only read what the first one set up, or guard it.
+*/
+class ConcurrentPlayer {
+public:
+    virtual ~ConcurrentPlayer() = default;
+};
+
+} // namespace arena
@@ -0,0 +1,42 @@
+// include/DangerField.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BattleSnapshot.h"
+
+namespace arena {
+
+/// Per-cell earliest tick at which a shell seen on the board could pass
+/// through, for every tank of a player to query instead of scanning for
+/// shells itself.
+///
+/// A satellite view shows where shells are ('*') but not where they head,
+/// so each shell casts all eight rays. Shells move two cells per tick and
+/// wrap around the board; a ray ends at the first wall or tank it hits.
+/// Tick 1 is the next turn.
+class DangerField {
+public:
+    static constexpr std::uint8_t NONE            = 255;
+    static constexpr int          DEFAULT_HORIZON = 8;   // ticks looked ahead
+
+    /// Recomputes the field for `snap`, looking `horizon` ticks ahead
+    /// (1..254). Costs one scan for '*' when there are no shells.
+    void compute(const BattleSnapshot& snap, int horizon = DEFAULT_HORIZON);
+
+    /// Earliest tick a shell could reach (x,y), NONE if none within the horizon.
+    std::uint8_t at(std::size_t x, std::size_t y) const {
+        return earliest_.empty() ? NONE : earliest_[y * cols_ + x];
+    }
+
+    /// True if no visible shell threatens any cell.
+    bool empty() const { return earliest_.empty(); }
+
+private:
+    std::size_t               rows_ = 0, cols_ = 0;
+    std::vector<std::uint8_t> earliest_;   // row-major; empty = no shells
+};
+
+} // namespace arena
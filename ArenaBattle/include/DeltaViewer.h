@@ -0,0 +1,32 @@
+// include/DeltaViewer.h
+#pragma once
+
+namespace arena {
+
+/*
+  Opt-in for delta battle info. A TankAlgorithm that also derives from
+  DeltaViewer declares that it keeps the picture from its previous views, so
+  with GameState::setDeltaViews(true), after its first GetBattleInfo the
+  engine only sends what changed:
+
+   - The SatelliteView passed to the Player still answers getObjectAt() for
+     the whole board, so an ordinary common::Player keeps working unchanged.
+   - MyBattleInfo::fromView() then yields delta == true, no snapshot, the
+     changed cells in `changes`, and the tank's position in selfX/selfY. The
+     tank folds it into its last info with MyBattleInfo::merge().
+   - The first view, and any view after the change log has moved on too far,
+     is a full one (delta == false); merge() handles both.
+
+  The Player serving a DeltaViewer must forward every update to it, or the
+  tank's picture falls behind the engine's.
+
+  Full views stay the default: a full view is one shared snapshot for all
+  tanks, while delta views give every tank its own grid, which only pays off
+  when boards are large and each tank sees few changes between views.
+*/
+class DeltaViewer {
+public:
+    virtual ~DeltaViewer() = default;
+};
+
+} // namespace arena
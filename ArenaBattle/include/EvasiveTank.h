@@ -3,6 +3,10 @@
 
 #include "common/TankAlgorithm.h"
 #include "MyBattleInfo.h"
+#include "Checkpoint.h"
+#include "DangerField.h"
+#include "DeltaViewer.h"
+#include "StateHash.h"
 
 namespace arena {
 
@@ -10,11 +14,13 @@ namespace arena {
  * EvasiveTank: stays out of shell paths and avoids obstacles.
  * − pulls a fresh view every other turn (needView_).
  * − first turn always GetBattleInfo to learn ammo.
- * − scans for shells (‘*’) up to two steps away in all 8 dirs.
+ * − asks its player's DangerField whether a shell can reach it next tick.
  * − treats walls (‘#’), mines (‘@’) and other tanks (‘1’/‘2’) as obstacles.
- * − picks the safest escape direction (farthest from nearest shell).
+ * − picks the safest escape direction (the neighbour shells reach last).
+ * − takes delta views (DeltaViewer.h) and keeps its own picture.
  */
-class EvasiveTank : public common::TankAlgorithm {
+class EvasiveTank : public common::TankAlgorithm, public Checkpointable, public DeltaViewer,
+                    public StateHashable {
 public:
     EvasiveTank(int playerIndex, int tankIndex);
     ~EvasiveTank() override = default;
@@ -22,6 +28,10 @@ public:
     void updateBattleInfo(common::BattleInfo& baseInfo) override;
     common::ActionRequest getAction() override;
 
+    void saveState(CheckpointWriter& out) const override;
+    bool loadState(CheckpointReader& in) override;
+    std::uint64_t stateHash() const override;
+
 private:
     MyBattleInfo   lastInfo_;
     int            direction_;    // 0..7
@@ -33,6 +43,8 @@ private:
 
     // Check if cell (x,y) is free (in-bounds, not wall/mine/tank)
     bool isFree(int x, int y) const;
+    // Earliest tick a visible shell can reach (x,y); DangerField::NONE if none
+    int dangerAt(int x, int y) const;
 };
 
 } // namespace arena
@@ -0,0 +1,66 @@
+// include/FlowField.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BattleSnapshot.h"
+#include "common/ActionRequest.h"
+
+namespace arena {
+
+/// Cost to the nearest firing position from every (x, y, direction) state
+/// of AggressiveTank's move model, computed once per turn by a Player so its
+/// tanks read their next action instead of each running its own search.
+///
+/// A firing position is a state whose ray (not wrapping) meets an enemy
+/// tank before leaving the board or meeting one of ours, walls in between
+/// allowed; without an `own` char every tank is an enemy. Tanks rotate by
+/// 45° or 90° in place and move forward onto any cell that is not a wall
+/// ('#'), a mine ('@') or a tank ('1', '2'): blank ' ' cells as the engine
+/// draws them, and '.' as maps do. The field is one multi-source search
+/// backwards from every firing position at once.
+class FlowField {
+public:
+    static constexpr int ROTATE_COST = 1;
+    static constexpr int MOVE_COST   = 1;
+    static constexpr std::uint16_t UNREACHABLE = UINT16_MAX;   // distance()
+    static constexpr std::uint16_t NO_TARGET   = UINT16_MAX;   // wallsAhead()
+
+    /// With `own` set (a player's tank char), the search stops once every
+    /// state of a cell holding `own` is final: costs no greater than those
+    /// are exact, the rest are left unfinished. Tanks of that player only
+    /// ever walk downhill from where they stand, so this is all they read.
+    void compute(const BattleSnapshot& snap, char own = 0);
+
+    /// Cost from (x,y,dir) to the nearest firing position (0 = firing
+    /// position), UNREACHABLE if there is none. Saturates below UNREACHABLE.
+    std::uint16_t distance(int x, int y, int dir) const { return dist_[state(x, y, dir)]; }
+
+    /// Walls between (x,y) and the target seen along dir, NO_TARGET if the
+    /// ray leaves the board. Saturates below NO_TARGET.
+    std::uint16_t wallsAhead(int x, int y, int dir) const { return walls_[state(x, y, dir)]; }
+
+    /// First step of a cheapest path from (x,y,dir): Shoot at a firing
+    /// position, DoNothing if none is reachable. Ties go to Left45, Right45,
+    /// Left90, Right90, then MoveForward.
+    common::ActionRequest next(int x, int y, int dir) const;
+
+    std::size_t rows() const { return rows_; }
+    std::size_t cols() const { return cols_; }
+
+private:
+    std::size_t state(int x, int y, int dir) const {
+        return (std::size_t(y) * cols_ + std::size_t(x)) * 8 + std::size_t(dir);
+    }
+
+    std::size_t                rows_ = 0, cols_ = 0;
+    enum : char { BLOCKED = 0, OPEN = 1, OWN = 2 };
+    std::vector<char>          kind_;          // per cell
+    std::vector<std::uint16_t> walls_;         // per state
+    std::vector<std::uint16_t> dist_;          // per state
+    std::vector<std::vector<std::uint32_t>> buckets_;   // search scratch
+};
+
+} // namespace arena
@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 #include "GameState.h"
+#include "GameObserver.h"
 
 namespace common {
     class PlayerFactory;
@@ -11,6 +12,12 @@ namespace common {
 
 namespace arena {
 
+/// Format of the per-turn action log written by run().
+enum class LogFormat {
+    Text,     ///< output_<map>.txt, one line per turn
+    Replay    ///< output_<map>.replay, compact binary (see Replay.h)
+};
+
 /// Loads a map, initializes GameState, and runs the main loop.
 class GameManager {
 public:
@@ -19,15 +26,69 @@ public:
                 std::unique_ptr<common::TankAlgorithmFactory> tFac);
     ~GameManager() = default;
 
-    /// Parses the map file and initializes GameState.
-    void readBoard(const std::string& map_file);
+    /// Loads the map file (see MapLoader.h) and initializes GameState.
+    /// Returns false with a message in `error` if the map cannot be used.
+    bool readBoard(const std::string& map_file, std::string& error);
+
+    /// Replaces the observer driven by run() (ConsoleObserver by default).
+    /// Pass a NullObserver for headless runs.
+    void setObserver(std::unique_ptr<GameObserver> observer);
+
+    /// Chooses the action log format (Text by default).
+    void setLogFormat(LogFormat format);
+
+    /// Threads used to gather tank decisions each turn (default 1).
+    void setDecisionThreads(std::size_t threads) { game_state_.setDecisionThreads(threads); }
+
+    /// Delta battle info for tanks that accept it (see DeltaViewer.h).
+    void setDeltaViews(bool on) { game_state_.setDeltaViews(on); }
+
+    /// Shells in satellite views (see GameState::setShellsInViews).
+    void setShellsInViews(bool on) { game_state_.setShellsInViews(on); }
+
+    /// Word-parallel shell phase (see GameState::setShellPlanes).
+    void setShellPlanes(bool on) { game_state_.setShellPlanes(on); }
+
+    /// Ends games whose whole state starts repeating (see
+    /// GameState::setCycleDetection) instead of playing them to MaxSteps.
+    void setCycleDetection(bool on) { game_state_.setCycleDetection(on); }
+
+    /// Profiles the turn pipeline during run() and writes the profile to
+    /// `path` at game end: CSV if it ends in ".csv", JSON otherwise.
+    void setProfileOutput(const std::string& path) { profile_file_ = path; }
+
+    /// Makes run() save a checkpoint to `path` right after turn `turn`.
+    void setCheckpointAt(std::size_t turn, const std::string& path) {
+        checkpoint_turn_ = turn;
+        checkpoint_file_ = path;
+    }
+
+    /// Writes the running game to `path` (format in Checkpoint.h).
+    bool saveCheckpoint(const std::string& path, std::string& error) const;
+
+    /// Replaces readBoard(): continues the game saved in `path`. run() then
+    /// logs only the turns played after the checkpoint.
+    bool loadCheckpoint(const std::string& path, std::string& error);
+
+    /// Executes the game loop until completion. False, with `error` set,
+    /// when the action log cannot be opened; nothing is played then.
+    bool run(std::string& error);
+
+    /// Map name run() derives its log file name from: the file name of
+    /// `map_file` without directory or extension ("maps/basic.txt" →
+    /// "basic", logged to output_basic.txt).
+    static std::string mapName(const std::string& map_file);
 
-    /// Executes the game loop until completion.
-    void run();
+    const GameState& getGameState() const { return game_state_; }
 
 private:
     GameState    game_state_;
     std::string  loaded_map_file_;
+    std::unique_ptr<GameObserver> observer_;
+    LogFormat    log_format_ = LogFormat::Text;
+    std::size_t  checkpoint_turn_ = 0;   // 0 = never
+    std::string  checkpoint_file_;
+    std::string  profile_file_;
 };
 
 } // namespace arena
@@ -0,0 +1,48 @@
+// include/GameObserver.h
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace arena {
+
+class GameState;
+
+/// Watches a game driven by GameManager::run(). All hooks default to no-ops,
+/// so an observer overrides only what it needs and the engine itself never
+/// touches the console.
+class GameObserver {
+public:
+    virtual ~GameObserver() = default;
+
+    /// Board is loaded, no turn played yet.
+    virtual void onGameStart(const GameState& /*state*/) {}
+
+    /// Turn `turn` (1-based) has been applied; its line is already logged.
+    virtual void onTurnEnd(std::size_t /*turn*/, const GameState& /*state*/) {}
+
+    /// Game is over; `logFile` holds the full action log.
+    virtual void onGameEnd(const GameState& /*state*/, const std::string& /*logFile*/) {}
+};
+
+/// Headless/batch runs: does nothing.
+class NullObserver final : public GameObserver {};
+
+/// Prints boards, per-tank decisions and the result, as the interactive
+/// tanks_game always has.
+class ConsoleObserver : public GameObserver {
+public:
+    /// Writes to stdout unless another stream is given.
+    ConsoleObserver();
+    explicit ConsoleObserver(std::ostream& out) : out_(out) {}
+
+    void onGameStart(const GameState& state) override;
+    void onTurnEnd(std::size_t turn, const GameState& state) override;
+    void onGameEnd(const GameState& state, const std::string& logFile) override;
+
+private:
+    std::ostream& out_;
+};
+
+} // namespace arena
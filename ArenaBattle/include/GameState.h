@@ -1,12 +1,22 @@
 #pragma once
 
+#include <iosfwd>
 #include <memory>
 #include <string>
 #include <vector>
-#include <map>
-#include <set>
 
+#include "ActionLog.h"
+#include "BattleChangeLog.h"
+#include "BitBoard.h"
 #include "Board.h"
+#include "CellChars.h"
+#include "CellSlotMap.h"
+#include "Checkpoint.h"
+#include "PhaseTimes.h"
+#include "ShellPlanes.h"
+#include "ShellPool.h"
+#include "StateHash.h"
+#include "ThreadPool.h"
 #include "MySatelliteView.h"
 #include "common/Player.h"
 #include "common/PlayerFactory.h"
@@ -25,20 +35,103 @@ public:
     ~GameState();
 
     /// Populate from a parsed Board, maxSteps, and shells per tank.
-    void initialize(const Board& board, std::size_t maxSteps, std::size_t numShells);
+    /// Pass the board as an rvalue to hand it over without a copy.
+    void initialize(Board board, std::size_t maxSteps, std::size_t numShells);
+
+    /// Gather tank decisions on `threads` threads (0/1 = on the calling
+    /// thread). Results do not depend on the thread count; see
+    /// ConcurrentPlayer.h for what algorithms and players must allow.
+    void setDecisionThreads(std::size_t threads);
+
+    /// Sends DeltaViewer tanks only the cells changed since their last view
+    /// (see DeltaViewer.h) instead of full views. Off by default; results
+    /// are the same either way.
+    void setDeltaViews(bool on) { deltaViews_ = on; }
+
+    /// Shows shells in satellite views as '*' (on empty cells), so tanks
+    /// and their players' DangerFields can see them. Off by default, which
+    /// keeps the original views: walls, mines and tanks only. Switching it
+    /// mid-game restarts delta views and cycle detection.
+    void setShellsInViews(bool on);
+
+    /// Resolves the shell phase on per-direction bit planes (see
+    /// ShellPlanes.h) instead of shell by shell, falling back to the
+    /// per-shell path for turns it cannot plan. Off by default: costs about
+    /// 7 bytes per cell and a few passes over them per turn, so it only
+    /// pays off on boards dense with shells. Results are the same.
+    void setShellPlanes(bool on);
+
+    /// Profiles every following turn into *times (nullptr stops). The
+    /// caller keeps ownership. No-op when built with ARENA_PROFILE=0.
+    void setPhaseTimes(PhaseTimes* times) { phaseTimes_ = times; }
+
+    /// Places a shell as if it had just been fired; for tools that stage
+    /// positions (benchmarks, scenarios). Coordinates must be on the board.
+    void spawnShell(int x, int y, int dir) {
+        shells_.spawn(Shell{x, y, dir});
+        shellHash_ += shellKey(shells_[shells_.size() - 1]);
+    }
+
+    /// Ends the game early, as a tie with its own result string, once the
+    /// whole state (board, tanks, shells, players, tank algorithms) repeats
+    /// an earlier turn's: deterministic participants would then loop until
+    /// maxSteps. Only runs when every player and tank algorithm implements
+    /// StateHashable (see StateHash.h). Off by default.
+    void setCycleDetection(bool on) { cycleDetection_ = on; }
+
+    /// Zobrist hash of the state between turns: board, tanks, shells, and
+    /// every StateHashable player and tank algorithm. The step counter is
+    /// not part of it.
+    std::uint64_t stateHash() const;
+
+    /// Character picture of the board for GetBattleInfo (no '%' marker).
+    SnapshotPtr buildBattleSnapshot() const;
+
+    /// Appends the whole game (board with wall damage, tanks, shells, step
+    /// counters, and any Checkpointable players/algorithms) to out.
+    void saveCheckpoint(CheckpointWriter& out) const;
+
+    /// Replaces this game with one written by saveCheckpoint(). Players and
+    /// algorithms are recreated from the factories, then handed their saved
+    /// state. On failure returns false with a message and leaves the game over.
+    bool loadCheckpoint(CheckpointReader& in, std::string& error);
 
     /// Advance one tick: rotate, move, shoot, resolve, and return actions.
     std::string advanceOneTurn();
 
+    /// Same as advanceOneTurn() without formatting the log line; the turn's
+    /// outcomes are in lastOutcomes(). Once warmed up, the engine phases
+    /// (everything but gathering decisions) make no heap allocations; a
+    /// turn only allocates while the shell count sets a new high.
+    void playOneTurn();
+
     bool        isGameOver()     const;
     std::string getResultString() const;
 
-    /// Display current board to stdout.
-    void printBoard() const;
+    /// Render the current board (with shells and tank arrows) to os.
+    void printBoard(std::ostream& os) const;
+
+    /// Requests each tank made last turn (index = tank slot), before the
+    /// backward-delay rules rewrote them, and whether each was ignored.
+    const std::vector<common::ActionRequest>& lastRequests() const { return lastRequests_; }
+    const std::vector<bool>&                  lastIgnored()  const { return lastIgnored_; }
+    /// Per-tank log entries of the last turn, in tank order.
+    const std::vector<TankOutcome>&           lastOutcomes() const { return lastOutcomes_; }
+
+    std::size_t getRows()      const { return rows_; }
+    std::size_t getCols()      const { return cols_; }
+    std::size_t getMaxSteps()  const { return maxSteps_; }
+    std::size_t getNumShells() const { return num_shells_; }
+    std::size_t getTankCount() const { return all_tanks_.size(); }
+    std::size_t getCurrentStep() const { return currentStep_; }
 
 private:
         
+    void createParticipants();
+    void rebuildTankIndex();
+
     // Helpers for each sub-step:
+    void gatherActions(std::vector<common::ActionRequest>& actions);
     void applyTankRotations(const std::vector<common::ActionRequest>& actions);
     void handleTankMineCollisions();
     void updateTankCooldowns();
@@ -50,11 +143,31 @@ private:
     void handleShooting(std::vector<bool>& ignored,
                         const std::vector<common::ActionRequest>& actions);
     void updateShellsWithOverrunCheck();
+    void moveShellsByPlan();
     void resolveShellCollisions();
     bool handleShellMidStepCollision(int x, int y);
+    std::uint32_t tankAt(int x, int y) const;
+    struct TankState;
+    void saveTanks(CheckpointWriter& out, const std::vector<TankState>& tanks) const;
+    bool loadTanks(CheckpointReader& in, std::vector<TankState>& tanks, std::string& what) const;
+    bool loadShells(CheckpointReader& in, std::vector<Shell>& shells, std::string& what) const;
+    void setBoardCell(int x, int y, CellContent c);
+    void noteCell(int x, int y);
+    const CellCharTable& viewChars() const;
+    void indexTank(std::size_t k);
+    void unindexTank(std::size_t k);
     void cleanupDestroyedEntities();
     void checkGameEndConditions();
     void filterRemainingShells();
+    void resetCellLayers();
+    void reserveShellScratch(std::size_t peak);
+    void resetStateHash();
+    void rehashTanks();
+    void checkForCycle();
+    bool sameAsCycleAnchor() const;
+    std::uint64_t shellKey(const Shell& s) const {
+        return zobrist::key(zobrist::Part::Shell, board_.index(s.x, s.y), std::uint64_t(s.dir));
+    }
 
     std::unique_ptr<common::SatelliteView>
     createSatelliteViewFor(int queryX, int queryY) const;
@@ -67,6 +180,12 @@ private:
     std::size_t maxSteps_{0}, currentStep_{0};
     bool        gameOver_{false};
     std::string resultStr_;
+    // Live satellite picture and the cells changed in it, kept in step with
+    // every board write (setBoardCell/noteCell); feeds GetBattleInfo.
+    BattleChangeLog changeLog_;
+    std::vector<common::ActionRequest> lastRequests_;
+    std::vector<bool>                  lastIgnored_;
+    std::vector<TankOutcome>           lastOutcomes_;
 
     struct TankState {
         int           player_index;
@@ -79,20 +198,82 @@ private:
     int           backwardDelayCounter{0};
     bool          lastActionBackwardExecuted{false};
 
+    bool operator==(const TankState&) const = default;
     };
     std::vector<TankState> all_tanks_;
-    std::vector<std::vector<std::size_t>> tankIdMap_;
+    std::vector<std::vector<std::size_t>> tankIdMap_;   // [player][tank index] → slot
+    // Live tanks by flat cell index → slot in all_tanks_, kept in sync
+    // with every move and death.
+    CellSlotMap            tankAtCell_;
+    CellSlotMap            tankDestCount_;
 
     std::vector<std::unique_ptr<common::TankAlgorithm>> all_tank_algorithms_;
     std::unique_ptr<common::Player> player1_, player2_;
+    bool concurrentPlayer_[3]{false, false, false};   // by player index
+    bool                       deltaViews_{false};
+    bool                       shellsInViews_{false};
+    std::vector<bool>          deltaViewer_;          // by slot, see DeltaViewer.h
+    std::vector<std::uint64_t> viewVersion_;          // changeLog_ version of each tank's last view
+    std::unique_ptr<ThreadPool> decisionPool_;
+    PhaseTimes*                 phaseTimes_{nullptr};
+    std::vector<std::size_t>    infoRequests_;        // tanks asking GetBattleInfo
     std::unique_ptr<common::PlayerFactory>        player_factory_;
     std::unique_ptr<common::TankAlgorithmFactory> tank_factory_;
 
-    struct Shell { int x, y, dir; };
-    
-    std::vector<Shell> shells_;
-    std::set<std::size_t> toRemove_;
-    std::map<std::pair<int,int>, std::vector<std::size_t>> positionMap_;
+    // Shells in creation order; shells removed this turn stay flagged dead
+    // in the pool until filterRemainingShells() compacts it.
+    ShellPool shells_;
+    // Lowest-index shell per cell, built during tank movement only once a
+    // tank steps onto a cell marked in shellCells_.
+    CellSlotMap shellAtCell_;
+
+    // Shell collision indexes, keyed by flat cell index and rebuilt per turn:
+    //   shellCells_ marks cells holding a shell (start of the turn during
+    //   shell movement, current during tank movement); cleared after use;
+    //   shellsByOldCell_ → first shell that started the turn in a cell,
+    //   chained in index order through nextShellAtOldCell_, holding only
+    //   shells whose first step lands on another shell's start cell (the
+    //   only ones a crossing check can match);
+    //   shellCellVisits_ lists (cell, shell) for every completed sub-step,
+    //   counted up to two in visitedOnce_/visitedTwice_.
+    BitBoard                   shellCells_;
+    CellSlotMap                shellsByOldCell_;
+    std::vector<std::uint32_t> nextShellAtOldCell_;
+    std::vector<std::pair<std::uint32_t, std::size_t>> shellCellVisits_;
+    BitBoard                   visitedOnce_, visitedTwice_;
+    // Only with setShellPlanes(true); kept in step with every board write.
+    std::unique_ptr<ShellPlanes> shellPlanes_;
+
+    // Per-turn scratch, kept between turns so a steady-state turn reuses
+    // the same storage: tank requests and deaths, tank old/new cells, and
+    // the shells' start cells, step deltas and first-step cells.
+    std::vector<common::ActionRequest> turnActions_;
+    std::vector<bool>                  turnKilled_;
+    std::vector<std::pair<int,int>>    tankOldPos_, tankNewPos_;
+    std::vector<std::pair<int,int>>    shellOldPos_, shellDelta_, shellFirstStep_;
+    mutable std::string                boardChars_;   // printBoard picture
+    // Most shells alive at once so far; scratch is sized for this many.
+    std::size_t shellPeak_{0};
+    bool        scratchWarm_{false};   // a turn has run since (re)loading
+
+    // Zobrist terms of stateHash() besides changeLog_.pictureHash(): wall
+    // hits, updated as walls take them; shells and tanks, summed (so equal
+    // ones do not cancel) and rehashed as a turn ends, since every shell
+    // moves and cooldowns tick each turn anyway.
+    std::uint64_t wallHash_{0}, shellHash_{0}, tankHash_{0};
+    bool          hashableParticipants_{false};   // all StateHashable
+
+    // Cycle detection (Brent): each turn's state is compared with the one
+    // at cycleAnchorStep_, which moves up to the current turn whenever
+    // cycleWindow_ turns have passed without a match, doubling the window.
+    // A hash match is confirmed on the board, tanks and shells.
+    bool                   cycleDetection_{false};
+    bool                   cycleAnchorSet_{false};
+    std::size_t            cycleAnchorStep_{0}, cycleWindow_{1};
+    std::uint64_t          cycleAnchorHash_{0};
+    std::vector<Cell>      cycleAnchorCells_;
+    std::vector<TankState> cycleAnchorTanks_;
+    std::vector<Shell>     cycleAnchorShells_;
 
     std::size_t num_shells_{0};
     int nextTankIndex_[3]{0,0,0};
@@ -0,0 +1,84 @@
+// include/Log.h
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <sstream>
+#include <string>
+
+// Logging for the engine and the algorithms. ARENA_LOG_LEVEL (make
+// LOG_LEVEL=N) is the most verbose level compiled in; statements above it
+// are discarded at compile time, arguments included. Lines that are compiled
+// in are still filtered by the runtime level and go through a buffered sink
+// (stderr unless setLogSink() says otherwise).
+//
+//   ARENA_LOG_DEBUG("plan pos=(" << x << "," << y << ")");
+#ifndef ARENA_LOG_LEVEL
+#define ARENA_LOG_LEVEL 2
+#endif
+
+namespace arena {
+
+enum class LogLevel : int {
+    Off   = 0,
+    Error = 1,
+    Warn  = 2,
+    Info  = 3,
+    Debug = 4,
+    Trace = 5
+};
+
+/// Lowercase level name ("debug", ...); parseLogLevel() is its inverse.
+const char* logLevelName(LogLevel level);
+bool        parseLogLevel(const std::string& name, LogLevel& out);
+
+/// Runtime filter, capped by ARENA_LOG_LEVEL. Defaults to everything that
+/// was compiled in.
+void     setLogLevel(LogLevel level);
+LogLevel logLevel();
+bool     logEnabled(LogLevel level);
+
+/// Where lines go (nullptr = std::cerr). Flushes what was buffered for the
+/// previous sink first. The stream must outlive its use as the sink.
+void setLogSink(std::ostream* sink);
+
+/// Lines are collected until `bytes` are pending (0 = write every line).
+/// Error lines always flush. Default 64 KiB.
+void setLogBuffer(std::size_t bytes);
+
+/// Writes out everything pending. Safe to call from any thread.
+void flushLog();
+
+/// One log line; written (with its level prefix) when destroyed. Use
+/// through the ARENA_LOG_* macros.
+class LogLine {
+public:
+    explicit LogLine(LogLevel level) : level_(level) {}
+    ~LogLine();
+    LogLine(const LogLine&)            = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    std::ostream& stream() { return out_; }
+
+private:
+    LogLevel           level_;
+    std::ostringstream out_;
+};
+
+} // namespace arena
+
+#define ARENA_LOG(level, msg)                                               \
+    do {                                                                    \
+        if constexpr (int(level) <= ARENA_LOG_LEVEL) {                      \
+            if (::arena::logEnabled(level)) {                               \
+                ::arena::LogLine arenaLogLine_(level);                      \
+                arenaLogLine_.stream() << msg;                              \
+            }                                                               \
+        }                                                                   \
+    } while (0)
+
+#define ARENA_LOG_ERROR(msg) ARENA_LOG(::arena::LogLevel::Error, msg)
+#define ARENA_LOG_WARN(msg)  ARENA_LOG(::arena::LogLevel::Warn,  msg)
+#define ARENA_LOG_INFO(msg)  ARENA_LOG(::arena::LogLevel::Info,  msg)
+#define ARENA_LOG_DEBUG(msg) ARENA_LOG(::arena::LogLevel::Debug, msg)
+#define ARENA_LOG_TRACE(msg) ARENA_LOG(::arena::LogLevel::Trace, msg)
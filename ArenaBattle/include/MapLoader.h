@@ -0,0 +1,42 @@
+// include/MapLoader.h
+#pragma once
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+#include "Board.h"
+
+namespace arena {
+
+/// Everything a map file describes.
+struct MapData {
+    std::string title;
+    std::size_t maxSteps  = 0;
+    std::size_t numShells = 0;
+    Board       board;
+};
+
+/*
+  Map file layout:
+
+    <title>
+    MaxSteps = <NUM>
+    NumShells = <NUM>
+    Rows = <NUM>
+    Cols = <NUM>
+    <grid rows: '.' empty, '#' wall, '@' mine, '1'/'2' tanks>
+
+  Blank lines and lines with other characters between grid rows are skipped.
+  Short rows are padded with empty cells, long rows are cut at Cols, and
+  missing rows are left empty.
+*/
+
+/// Reads the map in one pass, writing grid rows straight into map.board.
+/// Returns false with a message in `error` if the input is malformed.
+bool loadMap(std::istream& in, MapData& map, std::string& error);
+
+/// Same, for a file path.
+bool loadMap(const std::string& path, MapData& map, std::string& error);
+
+} // namespace arena
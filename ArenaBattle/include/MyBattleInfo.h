@@ -1,24 +1,62 @@
 #pragma once
 #include "common/BattleInfo.h"
-#include <vector>
+#include "common/SatelliteView.h"
+#include "BattleChangeLog.h"
+#include "BattleSnapshot.h"
+#include "Checkpoint.h"
 #include <cstddef>
+#include <memory>
+#include <vector>
 
 namespace arena {
-// This Struct is not allowed to contain pointers since it is shallowed copied to the tank algorithm.
+
+class DangerField;
+class FlowField;
+
+// Copies of this struct are cheap: the board itself lives in a shared,
+// immutable BattleSnapshot, so tanks can keep it without duplicating the grid.
 struct MyBattleInfo : public common::BattleInfo {
     std::size_t rows, cols;
-    std::vector<std::vector<char>> grid;
-    std::size_t selfX, selfY;      // tank’s own coord
+    SnapshotPtr snapshot;          // shared turn snapshot (no '%' marker)
+    std::size_t selfX, selfY;      // tank’s own coord, valid when selfKnown
+    bool        selfKnown = false; // false: the view had no '%' marker
     std::size_t shellsRemaining;   // <-- engine’s ammo count
+    bool        delta = false;     // true: `changes` patch the previous view, no snapshot
+    std::vector<CellChange> changes;
+    std::shared_ptr<const DangerField> danger;   // player's shell threats; may be null
+    std::shared_ptr<const FlowField>   flow;     // player's paths to firing positions; may be null
 
     MyBattleInfo(std::size_t r, std::size_t c)
       : rows(r)
       , cols(c)
-      , grid(r, std::vector<char>(c,' '))
       , selfX(0)
       , selfY(0)
       , shellsRemaining(0)
     {}
+
+    /// Cell as the tank saw it: '%' at its own position, ' ' before any view.
+    char at(std::size_t x, std::size_t y) const {
+        if (selfKnown && x == selfX && y == selfY && snapshot) return '%';
+        return snapshot ? snapshot->at(x, y) : ' ';
+    }
+
+    /// Wraps a satellite view; shares its snapshot when the view is ours,
+    /// otherwise copies it once through getObjectAt.
+    static MyBattleInfo fromView(const common::SatelliteView& sv,
+                                 std::size_t rows, std::size_t cols);
+
+    /// Folds a fresh view into this one (see DeltaViewer.h): a full view
+    /// replaces it, a delta view patches the grid, copying it first if it
+    /// is still shared. The result is always a full view.
+    void merge(const MyBattleInfo& update);
+
+    /// Checkpoint helpers for algorithms that keep a MyBattleInfo.
+    void save(CheckpointWriter& out) const;
+    bool load(CheckpointReader& in);
+
+    /// Hash of what save() writes, for StateHashable algorithms. The
+    /// danger and flow fields are left out: they follow from the snapshot.
+    std::uint64_t stateHash() const;
 };
 
 } // namespace arena
@@ -14,6 +14,9 @@ public:
     // Default ctor so you can do MyPlayerFactory{} in main
     MyPlayerFactory() = default;
 
+    // flowField: players share a per-turn FlowField with their tanks
+    explicit MyPlayerFactory(bool flowField) : flowField_(flowField) {}
+
     ~MyPlayerFactory() override = default;
 
     // Must match exactly common::PlayerFactory::create signature
@@ -26,11 +29,11 @@ public:
     {
         if (player_index == 1) {
             return std::make_unique<Player1>(
-                player_index, rows, cols, max_steps, num_shells
+                player_index, rows, cols, max_steps, num_shells, flowField_
             );
         } else {
             return std::make_unique<Player2>(
-                player_index, rows, cols, max_steps, num_shells
+                player_index, rows, cols, max_steps, num_shells, flowField_
             );
         }
     }
@@ -39,6 +42,7 @@ private:
     // no longer required; create() uses its parameters
     // std::size_t rows_ = 0;
     // std::size_t cols_ = 0;
+    bool flowField_ = false;
 };
 
 } // namespace arena
\ No newline at end of file
@@ -2,40 +2,47 @@
 #pragma once
 
 #include "common/SatelliteView.h"
+#include "BattleChangeLog.h"
+#include "BattleSnapshot.h"
+
 #include <vector>
 
 namespace arena {
 
-/// Concrete SatelliteView holding a full grid snapshot plus '%' at the querying tank.
+/// Concrete SatelliteView over a shared turn snapshot plus '%' at the querying tank.
 class MySatelliteView : public common::SatelliteView {
 public:
-    /// @param board   current board snapshot (grid[y][x])
-    /// @param rows    number of rows in the grid
-    /// @param cols    number of columns
-    /// @param queryX  x-coordinate of querying tank
-    /// @param queryY  y-coordinate of querying tank
-    MySatelliteView(const std::vector<std::vector<char>>& board,
-                    std::size_t rows,
-                    std::size_t cols,
+    /// @param snapshot  this turn's board snapshot (shared, not copied)
+    /// @param queryX    x-coordinate of querying tank
+    /// @param queryY    y-coordinate of querying tank
+    /// @param changes   for a DeltaViewer tank: cells changed since its last
+    ///                  view (must outlive the view), nullptr for a full view
+    MySatelliteView(SnapshotPtr snapshot,
                     std::size_t queryX,
-                    std::size_t queryY)
-      : rows_(rows), cols_(cols), grid_(board)
-    {
-        if (queryX < cols_ && queryY < rows_) {
-            grid_[queryY][queryX] = '%';
-        }
-    }
+                    std::size_t queryY,
+                    const std::vector<CellChange>* changes = nullptr)
+      : snapshot_(std::move(snapshot)), queryX_(queryX), queryY_(queryY), changes_(changes)
+    {}
 
     char getObjectAt(std::size_t x, std::size_t y) const override {
-        if (x >= cols_ || y >= rows_) {
+        if (x >= snapshot_->cols || y >= snapshot_->rows) {
             return '&';
         }
-        return grid_[y][x];
+        if (x == queryX_ && y == queryY_) {
+            return '%';
+        }
+        return snapshot_->at(x, y);
     }
 
+    const SnapshotPtr& snapshot() const { return snapshot_; }
+    std::size_t        queryX()   const { return queryX_; }
+    std::size_t        queryY()   const { return queryY_; }
+    const std::vector<CellChange>* changes() const { return changes_; }
+
 private:
-    std::size_t rows_, cols_;
-    std::vector<std::vector<char>> grid_;
+    SnapshotPtr snapshot_;
+    std::size_t queryX_, queryY_;
+    const std::vector<CellChange>* changes_;
 };
 
 } // namespace arena
@@ -13,6 +13,10 @@ public:
     // Default ctor
     MyTankAlgorithmFactory() = default;
 
+    // incrementalReplan: AggressiveTank keeps still-valid plans across refreshes
+    explicit MyTankAlgorithmFactory(bool incrementalReplan)
+        : incrementalReplan_(incrementalReplan) {}
+
     ~MyTankAlgorithmFactory() override = default;
 
     // Must match exactly common::TankAlgorithmFactory::create signature
@@ -21,7 +25,7 @@ public:
     {
         if (player_index == 1) {
             return std::make_unique<arena::AggressiveTank>(
-                player_index, tank_index
+                player_index, tank_index, incrementalReplan_
             );
         } else {
             return std::make_unique<arena::EvasiveTank>(
@@ -30,6 +34,8 @@ public:
         }
     }
 
+private:
+    bool incrementalReplan_ = false;
 };
 
 } // namespace common
\ No newline at end of file
@@ -0,0 +1,138 @@
+// include/PhaseTimes.h
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Turn-phase profiling. Build with -DARENA_PROFILE=0 (make PROFILE=0) to
+// compile every probe out; otherwise a probe costs one null check per phase
+// until a PhaseTimes is attached with GameState::setPhaseTimes().
+#ifndef ARENA_PROFILE
+#define ARENA_PROFILE 1
+#endif
+
+namespace arena {
+
+/// Sub-steps of GameState::playOneTurn, in execution order.
+enum class TurnPhase : std::uint8_t {
+    Gather,           // getAction + battle info
+    BackwardDelay,
+    Rotations,
+    Mines,
+    BackwardCheck,
+    ShellMove,
+    ShellCollisions,
+    Shooting,
+    TankMoves,
+    Cleanup,
+    EndCheck,
+    Count
+};
+
+constexpr std::size_t TURN_PHASE_COUNT = std::size_t(TurnPhase::Count);
+
+inline const char* phaseName(TurnPhase p) {
+    static constexpr const char* names[TURN_PHASE_COUNT] = {
+        "gather", "backward_delay", "rotations", "mines", "backward_check",
+        "shell_move", "shell_collisions", "shooting", "tank_moves",
+        "cleanup", "end_check"
+    };
+    return names[std::size_t(p)];
+}
+
+/// Counts per power-of-two bucket: bucket b holds values in [2^b, 2^(b+1)),
+/// bucket 0 also holds 0.
+struct Log2Histogram {
+    static constexpr std::size_t BUCKETS = 40;
+    std::uint64_t counts[BUCKETS]{};
+
+    void add(std::uint64_t v);
+    /// Upper bound of the bucket holding quantile q (0..1), 0 if empty.
+    std::uint64_t quantile(double q) const;
+};
+
+/// Running sum/max of one per-turn quantity, with its distribution.
+struct TurnStat {
+    std::uint64_t total = 0;
+    std::uint64_t max   = 0;
+    Log2Histogram hist;
+
+    void add(std::uint64_t v) {
+        total += v;
+        if (v > max) max = v;
+        hist.add(v);
+    }
+};
+
+/// Profile of every turn played while attached: wall time per phase (ns)
+/// and entity counts at the end of each turn.
+struct PhaseTimes {
+    TurnStat      phase[TURN_PHASE_COUNT];
+    TurnStat      turnNanos;
+    TurnStat      tanksAlive;
+    TurnStat      shells;
+    TurnStat      infoRequests;
+    std::uint64_t turns = 0;
+
+    /// One row per phase and per entity count:
+    ///   metric,turns,total,mean,max,p50,p90,p99
+    /// Percentiles are histogram bucket upper bounds.
+    void writeCsv(std::ostream& os) const;
+    /// Same figures plus the raw histograms.
+    void writeJson(std::ostream& os) const;
+};
+
+#if ARENA_PROFILE
+
+/// Charges the time since the previous lap to a phase. Does nothing (and
+/// never reads the clock) when constructed with a null PhaseTimes.
+class PhaseClock {
+public:
+    explicit PhaseClock(PhaseTimes* times) : times_(times) {
+        if (times_) start_ = last_ = std::chrono::steady_clock::now();
+    }
+
+    bool active() const { return times_ != nullptr; }
+
+    void lap(TurnPhase p) {
+        if (!times_) return;
+        auto now = std::chrono::steady_clock::now();
+        times_->phase[std::size_t(p)].add(nanosBetween(last_, now));
+        last_ = now;
+    }
+
+    /// Closes the turn; call only when active().
+    void endTurn(std::size_t tanksAlive, std::size_t shells, std::size_t infoRequests) {
+        times_->turnNanos.add(nanosBetween(start_, last_));
+        times_->tanksAlive.add(tanksAlive);
+        times_->shells.add(shells);
+        times_->infoRequests.add(infoRequests);
+        ++times_->turns;
+    }
+
+private:
+    static std::uint64_t nanosBetween(std::chrono::steady_clock::time_point a,
+                                      std::chrono::steady_clock::time_point b) {
+        return std::uint64_t(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count());
+    }
+
+    PhaseTimes* times_;
+    std::chrono::steady_clock::time_point start_, last_;
+};
+
+#else
+
+class PhaseClock {
+public:
+    explicit PhaseClock(PhaseTimes*) {}
+    static constexpr bool active() { return false; }
+    void lap(TurnPhase) {}
+    void endTurn(std::size_t, std::size_t, std::size_t) {}
+};
+
+#endif
+
+} // namespace arena
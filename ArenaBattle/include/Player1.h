@@ -3,16 +3,29 @@
 #include "common/Player.h"
 #include "common/SatelliteView.h"
 #include "MyBattleInfo.h"
+#include "Checkpoint.h"
+#include "ConcurrentPlayer.h"
+#include "DangerField.h"
+#include "FlowField.h"
+#include "StateHash.h"
+#include "TurnFieldCache.h"
 
 namespace arena {
 
-class Player1 : public common::Player {
+/// Updates for different tanks may run concurrently (ConcurrentPlayer.h):
+/// the initial shells go with the first update, which the engine runs on
+/// its own, and the field caches lock.
+class Player1 : public common::Player, public Checkpointable, public StateHashable,
+                public ConcurrentPlayer {
 public:
+    /// With flowField, every view also carries a FlowField shared by all
+    /// of this player's tanks (AggressiveTank plans from it).
     Player1(int player_index,
             std::size_t rows,
             std::size_t cols,
             std::size_t max_steps,
-            std::size_t num_shells);
+            std::size_t num_shells,
+            bool        flowField = false);
 
     ~Player1() override = default;
 
@@ -21,10 +34,18 @@ public:
         common::SatelliteView  &sv
     ) override;
 
+    void saveState(CheckpointWriter& out) const override;
+    bool loadState(CheckpointReader& in) override;
+    /// Only firstInfo_ changes; the cached fields follow from the views.
+    std::uint64_t stateHash() const override { return firstInfo_; }
+
 private:
     std::size_t rows_, cols_;
     std::size_t initialShells_;  // from ctor’s num_shells
     bool        firstInfo_ = true;
+    TurnFieldCache<DangerField> danger_;   // shared by all our tanks each turn
+    bool                        flowField_ = false;
+    TurnFieldCache<FlowField>   flow_;     // only with flowField_
 };
 
 } // namespace arena
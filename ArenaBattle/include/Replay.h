@@ -0,0 +1,56 @@
+// include/Replay.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "ActionLog.h"
+
+namespace arena {
+
+/// Map metadata stored at the head of a replay.
+struct ReplayHeader {
+    std::string map_name;
+    std::size_t rows = 0, cols = 0;
+    std::size_t max_steps = 0, num_shells = 0;
+    std::size_t tank_count = 0;
+};
+
+/*
+  Binary replay (output_<map>.replay), all integers unsigned LEB128 varints:
+
+    "TKRP" u8 version
+    rows cols max_steps num_shells tank_count name_len name_bytes
+    then records, each starting with a tag byte:
+      'T'  one turn: runs of {skip, lit, lit outcome bytes} covering all
+           tank_count tanks; skipped tanks repeat last turn's outcome
+      'R'  result: len bytes — always the last record
+
+  Outcome bytes are TankOutcome values. Dead tanks and tanks repeating an
+  action cost nothing after their first turn, so long games stay small.
+*/
+class ReplayWriter : public ActionLog {
+public:
+    static constexpr std::uint8_t VERSION = 1;
+
+    ReplayWriter(std::ostream& out, const ReplayHeader& header);
+
+    void writeTurn(const std::vector<TankOutcome>& outcomes) override;
+    void writeResult(const std::string& result) override;
+
+private:
+    void putVarint(std::size_t v);
+
+    std::ostream&             out_;
+    std::vector<TankOutcome>  prev_;
+    std::vector<char>         buf_;   // one record, reused between turns
+};
+
+/// Rewrites a replay as the text action log, byte for byte.
+/// Returns false and fills `error` on malformed input.
+bool replayToText(std::istream& in, std::ostream& out, std::string& error);
+
+} // namespace arena
@@ -0,0 +1,93 @@
+// include/ShellPlanes.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BitPlane.h"
+#include "Board.h"
+#include "ShellPool.h"
+
+namespace arena {
+
+/*
+  Word-parallel shell phase (GameState::setShellPlanes). Walls, damaged
+  walls and tanks are kept as BitPlanes next to the Board; each turn the
+  shells are dropped into one plane per direction and both sub-steps are
+  worked out by shifting and masking whole planes:
+
+   - head-on crossings: a shell whose first step holds a shell flying the
+     other way (start[d] & shift(start[opposite], opposite)),
+   - which shells end a sub-step on a wall or tank and die there, and what
+     is left of the walls and tanks for the next sub-step,
+   - cells that two or more shells pass through (same-cell hits), counted
+     to two across both sub-steps.
+
+  GameState then makes one cheap pass per sub-step in shell order to move
+  the shells and apply the wall and tank hits, asking the planes only who
+  crossed and who shares a cell.
+
+  The per-shell engine resolves a sub-step in shell order, so a few cases
+  depend on that order. They are handled, or the turn falls back to the
+  per-shell path (plan() returns false) before anything changes:
+
+   - Several shells entering one wall or tank in one sub-step: the lowest
+     one (two, for an undamaged wall) dies on it and the rest fly through
+     the emptied cell. Those cells are rare and sorted out one by one by
+     shell index.
+   - Two shells starting a turn on one cell: a crossing then depends on
+     which of them is still alive when the other moves. Falls back.
+   - Boards under 4 cells across: a shell's second step can land where
+     another started, which the per-shell crossing rule also checks.
+     Falls back.
+
+  Memory: about 25 bits plus one 32-bit shell index per cell.
+*/
+class ShellPlanes {
+public:
+    /// Builds the wall, damage and tank planes from `board`.
+    void reset(const Board& board);
+
+    /// Brings the planes in line with `cell`, just written at (x, y).
+    void update(int x, int y, const Cell& cell);
+
+    /// Plans the shell phase for `shells` at their start-of-turn cells,
+    /// with the board as update() last saw it. False, with nothing
+    /// planned, when the turn needs the per-shell path.
+    bool plan(const ShellPool& shells);
+
+    /// After plan(): whether the shell, still at its start cell, is met
+    /// head-on and stops there.
+    bool crossed(const Shell& s) const { return !start_[s.dir].test(s.x, s.y); }
+
+    /// After plan(): whether the shell, moved by both sub-steps, is still
+    /// flying. For consistency checks.
+    bool arrived(const Shell& s) const { return step_[s.dir].test(s.x, s.y); }
+
+    /// After plan(): whether two or more shells passed through (x, y).
+    bool shared(int x, int y) const { return visitedTwice_.test(x, y); }
+
+private:
+    /// Clash cells of one word, found while resolving a sub-step.
+    struct Clash {
+        std::size_t   word;
+        std::uint64_t cells;    // blockers entered by two or more shells
+        std::uint64_t single;   // of those, the ones a single hit removes
+    };
+
+    void subStep(int back);
+    void settleClashes(int back);
+
+    std::size_t rows_ = 0, cols_ = 0;
+    BitPlane walls_, damaged_, tanks_;          // the board, kept by update()
+    BitPlane nextWalls_, nextDamaged_, nextTanks_;   // as the sub-steps leave it
+    BitPlane start_[8];       // shells by direction at the start, minus crossings
+    BitPlane step_[8];        // shells by direction after the current sub-step
+    BitPlane shifted_;
+    BitPlane visitedOnce_, visitedTwice_;
+    std::vector<std::uint32_t> shellAt_;        // start cell → shell index
+    std::vector<Clash>         clashes_;
+};
+
+} // namespace arena
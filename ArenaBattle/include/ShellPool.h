@@ -0,0 +1,53 @@
+// include/ShellPool.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace arena {
+
+/// A shell in flight: position and one of the 8 directions.
+struct Shell { int x, y, dir; };
+
+/// Dense shell storage. Shells are iterated by index in creation order.
+/// Removal during a turn only sets a bit; compact() drops all flagged
+/// shells in one in-place pass at the end of the turn, so nothing is
+/// erased or reallocated mid-turn.
+class ShellPool {
+public:
+    std::size_t size()  const { return shells_.size(); }
+    bool        empty() const { return shells_.empty(); }
+
+    Shell&       operator[](std::size_t i)       { return shells_[i]; }
+    const Shell& operator[](std::size_t i) const { return shells_[i]; }
+
+    auto begin()       { return shells_.begin(); }
+    auto end()         { return shells_.end(); }
+    auto begin() const { return shells_.begin(); }
+    auto end()   const { return shells_.end(); }
+
+    /// Appends a live shell.
+    void spawn(const Shell& s) {
+        if ((shells_.size() >> 6) >= dead_.size()) dead_.push_back(0);
+        shells_.push_back(s);
+    }
+
+    /// Flags the shell at index i for removal at the next compact().
+    void kill(std::size_t i)         { dead_[i >> 6] |= (std::uint64_t(1) << (i & 63)); }
+    bool isDead(std::size_t i) const { return (dead_[i >> 6] >> (i & 63)) & 1; }
+
+    /// Removes every flagged shell, keeping survivors in creation order.
+    void compact();
+
+    void clear() {
+        shells_.clear();
+        dead_.assign(dead_.size(), 0);
+    }
+
+private:
+    std::vector<Shell>         shells_;
+    std::vector<std::uint64_t> dead_;   // bitset over indices
+};
+
+} // namespace arena
@@ -0,0 +1,66 @@
+// include/StateHash.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace arena {
+
+/// Zobrist hashing of game states. Keys are not tabled but derived from
+/// (part, fields) by a 64-bit mixer, so a board of any size costs no key
+/// memory. An unordered collection hashes to the XOR of its parts' keys
+/// and is updated by XOR-ing a part's old key out and its new key in;
+/// ordered data is folded with combine().
+namespace zobrist {
+
+enum class Part : std::uint64_t {
+    PictureCell = 1,   // satellite character of a cell
+    WallHits,          // hits taken by a wall cell
+    Tank,
+    Shell,
+    Participant        // a player's or tank algorithm's stateHash()
+};
+
+/// splitmix64 finalizer.
+inline std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30; x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27; x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+inline std::uint64_t key(Part part, std::uint64_t a, std::uint64_t b = 0) {
+    return mix(mix((std::uint64_t(part) << 56) ^ a) ^ b);
+}
+
+/// Folds v into an ordered hash.
+inline std::uint64_t combine(std::uint64_t h, std::uint64_t v) {
+    return mix(h ^ (v + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2)));
+}
+
+/// Key of one cell of a satellite picture. Blank cells have none, so an
+/// all-blank picture hashes to 0.
+inline std::uint64_t cellKey(std::size_t cell, char c) {
+    return c == ' ' ? 0 : key(Part::PictureCell, cell, std::uint8_t(c));
+}
+
+/// Hash of a whole row-major picture of n cells.
+inline std::uint64_t pictureHash(const char* cells, std::size_t n) {
+    std::uint64_t h = 0;
+    for (std::size_t i = 0; i < n; ++i) h ^= cellKey(i, cells[i]);
+    return h;
+}
+
+} // namespace zobrist
+
+/// Optional interface for TankAlgorithm and Player implementations whose
+/// decisions depend only on their state and what the engine tells them.
+/// stateHash() must be equal for equal states; GameState's cycle detector
+/// (setCycleDetection) only runs when every participant implements it.
+class StateHashable {
+public:
+    virtual ~StateHashable() = default;
+    virtual std::uint64_t stateHash() const = 0;
+};
+
+} // namespace arena
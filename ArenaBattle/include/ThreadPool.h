@@ -0,0 +1,59 @@
+// include/ThreadPool.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace arena {
+
+/// Fixed-size work-stealing pool. Each worker owns a deque: it pops its own
+/// newest task first and, when empty, steals the oldest task of another
+/// worker. submit() spreads tasks round-robin over the deques.
+class ThreadPool {
+public:
+    /// threads == 0 → one per hardware thread.
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return workers_.size(); }
+
+    void submit(std::function<void()> task);
+
+    /// Blocks until every submitted task has finished.
+    void wait();
+
+    /// Runs fn(i) for every i in [0, n) across the workers and waits.
+    /// Must not be mixed with other outstanding submit() calls.
+    void parallelFor(std::size_t n, const std::function<void(std::size_t)>& fn);
+
+private:
+    struct Queue {
+        std::mutex                        mtx;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(std::size_t self);
+    bool tryPop(std::size_t self, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread>            workers_;
+    std::atomic<std::size_t>            nextQueue_{0};
+
+    std::mutex              mtx_;        // guards the counters below
+    std::condition_variable workCv_, doneCv_;
+    std::size_t             queued_{0};  // submitted, not yet picked up
+    std::size_t             pending_{0}; // submitted, not yet finished
+    bool                    stop_{false};
+};
+
+} // namespace arena
@@ -0,0 +1,61 @@
+// include/TurnFieldCache.h
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "BattleSnapshot.h"
+#include "MyBattleInfo.h"
+#include "MySatelliteView.h"
+#include "common/SatelliteView.h"
+
+namespace arena {
+
+/// One Field per turn for a Player (DangerField, FlowField): the first tank
+/// updated in a turn pays for it, the others share it. Turns are told apart
+/// by the snapshot version (see BattleSnapshot); views without one get a
+/// field of their own. Field needs compute(const BattleSnapshot&, args...),
+/// where args are the same on every call. Fields are pooled: tanks keep
+/// the one from their last view, and a new turn recomputes in place into
+/// any field they have all let go of. get() may be called concurrently.
+template <typename Field>
+class TurnFieldCache {
+public:
+    /// Field for the view `info` was made from (MyBattleInfo::fromView).
+    template <typename... Args>
+    std::shared_ptr<const Field> get(const common::SatelliteView& sv,
+                                     const MyBattleInfo& info, const Args&... args) {
+        SnapshotPtr snap = info.snapshot;
+        if (auto* mine = dynamic_cast<const MySatelliteView*>(&sv)) snap = mine->snapshot();
+        if (!snap) return nullptr;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (snap->version != 0 && snap->version == version_ && source_.lock() == snap)
+            return field_;
+
+        // recompute in a pooled field no tank still holds
+        field_.reset();
+        auto reusable = std::find_if(pool_.begin(), pool_.end(),
+                                     [](const auto& f) { return f.use_count() == 1; });
+        if (reusable == pool_.end())
+            reusable = pool_.insert(pool_.end(), std::make_shared<Field>());
+        field_ = *reusable;
+        field_->compute(*snap, args...);
+        source_  = snap;
+        version_ = snap->version;
+        return field_;
+    }
+
+private:
+    std::mutex                          mutex_;
+    std::weak_ptr<const BattleSnapshot> source_;   // weak: must not pin it
+    std::uint64_t                       version_ = 0;
+    std::shared_ptr<Field>              field_;    // this turn's, also in pool_
+    std::vector<std::shared_ptr<Field>> pool_;     // one per field still in use
+};
+
+} // namespace arena
@@ -0,0 +1,39 @@
+// src/ActionLog.cpp
+#include "ActionLog.h"
+#include "utils.h"
+
+#include <ostream>
+
+using namespace arena;
+using common::ActionRequest;
+
+void arena::appendTurnLine(std::string& out, const std::vector<TankOutcome>& outcomes) {
+    for (std::size_t k = 0; k < outcomes.size(); ++k) {
+        const TankOutcome o   = outcomes[k];
+        const ActionRequest a = outcomeAction(o);
+        if (o & OUTCOME_KILLED) {
+            // tank is dead (died this turn or earlier)
+            if (a == ActionRequest::DoNothing) {
+                out += "killed";
+            } else {
+                out += actionToString(a);
+                out += " (killed)";
+            }
+        } else {
+            out += actionToString(a);
+            if (o & OUTCOME_IGNORED) out += " (ignored)";
+        }
+        if (k + 1 < outcomes.size()) out += ", ";
+    }
+}
+
+void TextActionLog::writeTurn(const std::vector<TankOutcome>& outcomes) {
+    line_.clear();
+    appendTurnLine(line_, outcomes);
+    line_ += '\n';
+    out_ << line_;
+}
+
+void TextActionLog::writeResult(const std::string& result) {
+    out_ << result << "\n";
+}
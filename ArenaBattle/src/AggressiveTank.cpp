@@ -1,10 +1,13 @@
 
 // AggressiveTank.cpp
 #include "AggressiveTank.h"
-#include <queue>
+#include "FlowField.h"
 #include <limits>
 #include <algorithm>
-#include <iostream>
+#include <cstdint>
+#include <vector>
+#include <ostream>
+#include "Log.h"
 
 using namespace arena;
 using namespace common;
@@ -12,30 +15,132 @@ using namespace common;
 static constexpr int DX[8] = {0,1,1,1,0,-1,-1,-1};
 static constexpr int DY[8] = {-1,-1,0,1,1,1,0,-1};
 
-AggressiveTank::AggressiveTank(int playerIndex, int /*tankIndex*/)
-  : lastInfo_(0,0), curDir_(playerIndex==1?2:6) {
-    std::cerr << "DEBUG: AggressiveTank init player=" << playerIndex << " dir=" << curDir_ << "\n";
+namespace {
+
+// computePlan() scratch. States are (cell*8 + dir); an entry is valid only
+// while its stamp equals `epoch`, so bumping the epoch resets every entry
+// without touching the arrays. One instance per thread: a planner run never
+// yields, and tanks sharing a thread share the memory instead of each
+// holding rows*cols*8 entries.
+struct PlanScratch {
+    struct Node {
+        int           dist;
+        int           parent;
+        ActionRequest via;
+    };
+    static constexpr int LOS_NONE = -1;
+
+    std::vector<Node>          nodes;
+    std::vector<std::uint32_t> stamp;
+    std::uint32_t              epoch = 0;
+    // Line-of-sight memo, indexed and stamped like the nodes: walls crossed
+    // before the first object seen from a cell along a direction, or
+    // LOS_NONE if the ray leaves the board.
+    std::vector<int>           losWalls;
+    std::vector<std::uint32_t> losStamp;
+    std::vector<int>           losPath;
+    std::vector<std::vector<int>> buckets;   // dial queue by cost % buckets.size()
+    std::vector<int>           level;        // bucket being expanded
+
+    /// Starts a new plan over `total` states.
+    void begin(std::size_t total) {
+        if (stamp.size() != total) {
+            stamp.assign(total, 0);    nodes.resize(total);
+            losStamp.assign(total, 0); losWalls.resize(total);
+            epoch = 0;
+        }
+        if (++epoch == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            std::fill(losStamp.begin(), losStamp.end(), 0);
+            epoch = 1;
+        }
+    }
+};
+
+PlanScratch& planScratch() {
+    thread_local PlanScratch scratch;
+    return scratch;
+}
+
+// Walls crossed along `dir` from (x,y) before the first cell that is neither
+// '#' nor '.', or LOS_NONE if the ray leaves the board first. A ray's answer
+// is the next cell's answer (plus one if that cell is a wall), so a walk
+// stops at the first memoized cell and fills in every cell it passed:
+// each (cell, dir) is walked at most once per plan.
+int rayWalls(const MyBattleInfo& info, PlanScratch& ps, int x, int y, int dir) {
+    int rows=(int)info.rows, cols=(int)info.cols;
+    ps.losPath.clear();
+    int result=PlanScratch::LOS_NONE;
+    while(true){
+        int s=(y*cols+x)*8+dir;
+        if(ps.losStamp[s]==ps.epoch){
+            result=ps.losWalls[s];
+            // reached from the previous path cell: count this cell's wall
+            if(!ps.losPath.empty() && result!=PlanScratch::LOS_NONE && info.at(x,y)=='#') ++result;
+            break;
+        }
+        ps.losPath.push_back(s);
+        x+=DX[dir]; y+=DY[dir];
+        if(x<0||x>=cols||y<0||y>=rows){ result=PlanScratch::LOS_NONE; break; }
+        char c=info.at(x,y);
+        if(c=='#') continue;
+        if(c!='.'){ result=0; break; }
+    }
+    if(ps.losPath.empty()) return result;
+    // unwind: walls seen from each cell = walls seen from the next one,
+    // plus one if that next cell is a wall
+    for(auto it=ps.losPath.rbegin(); it!=ps.losPath.rend(); ++it){
+        int s=*it;
+        ps.losStamp[s]=ps.epoch;
+        ps.losWalls[s]=result;
+        int px=(s/8)%cols, py=(s/8)/cols;
+        if(result!=PlanScratch::LOS_NONE && info.at(px,py)=='#') ++result;
+    }
+    return ps.losWalls[ps.losPath.front()];
+}
+
+/// Streams as " 3 0 5": action codes for debug lines.
+struct ActionList {
+    const std::vector<common::ActionRequest>& actions;
+};
+
+std::ostream& operator<<(std::ostream& os, const ActionList& list) {
+    for (auto a : list.actions) os << ' ' << static_cast<int>(a);
+    return os;
+}
+
+} // namespace
+
+AggressiveTank::AggressiveTank(int playerIndex, int /*tankIndex*/, bool incrementalReplan)
+  : lastInfo_(0,0), curDir_(playerIndex==1?2:6), ownTank_(char('0'+playerIndex)),
+    incrementalReplan_(incrementalReplan) {
+    ARENA_LOG_DEBUG("AggressiveTank init player=" << playerIndex << " dir=" << curDir_);
 }
 
 void AggressiveTank::updateBattleInfo(BattleInfo& info) {
-    lastInfo_ = static_cast<MyBattleInfo&>(info);
+    lastInfo_.merge(static_cast<MyBattleInfo&>(info));
     if(shellsLeft_<0) shellsLeft_=static_cast<int>(lastInfo_.shellsRemaining);
-    seenInfo_=true; ticksSinceInfo_=0;
+    // without our position there is nothing to plan from: ask again
+    seenInfo_=lastInfo_.selfKnown; ticksSinceInfo_=0;
+    if(!seenInfo_) { plan_.clear(); return; }
+    // the plan can only survive if we are where it thinks we are
+    bool onTrack = curX_==static_cast<int>(lastInfo_.selfX) && curY_==static_cast<int>(lastInfo_.selfY);
     curX_=static_cast<int>(lastInfo_.selfX);
     curY_=static_cast<int>(lastInfo_.selfY);
-    plan_.clear();
-    std::cerr << "DEBUG: updateBattleInfo pos=("<<curX_<<","<<curY_<<") shells="<<shellsLeft_<<"\n";
+    if(!(incrementalReplan_ && onTrack && !plan_.empty() && planStillValid())) plan_.clear();
+    else ARENA_LOG_DEBUG("plan kept steps="<<plan_.size());
+    ARENA_LOG_DEBUG("updateBattleInfo pos=("<<curX_<<","<<curY_<<") shells="<<shellsLeft_);
 }
 
 common::ActionRequest AggressiveTank::getAction() {
-    std::cerr<<"DEBUG: getAction seen="<<seenInfo_<<" ticks="<<ticksSinceInfo_<<" cd="<<algoCooldown_<<" plan="<<plan_.size()<<" pos=("<<curX_<<","<<curY_<<") dir="<<curDir_<<" shells="<<shellsLeft_<<"\n";
-    if(!seenInfo_) { std::cerr<<"DEBUG: ->GetBattleInfo no info\n"; return ActionRequest::GetBattleInfo; }
-    if(++ticksSinceInfo_>=REFRESH_INTERVAL) { seenInfo_=false; std::cerr<<"DEBUG: ->GetBattleInfo refresh\n"; return ActionRequest::GetBattleInfo; }
-    if(algoCooldown_>0) { --algoCooldown_; curDir_=(curDir_+7)%8; std::cerr<<"DEBUG: ->RotateLeft45 cd\n"; return ActionRequest::RotateLeft45; }
-    if(plan_.empty()) { std::cerr<<"DEBUG: computing plan\n"; computePlan(); }
+    ARENA_LOG_DEBUG("getAction seen="<<seenInfo_<<" ticks="<<ticksSinceInfo_<<" cd="<<algoCooldown_<<" plan="<<plan_.size()<<" pos=("<<curX_<<","<<curY_<<") dir="<<curDir_<<" shells="<<shellsLeft_);
+    if(!seenInfo_) { ARENA_LOG_DEBUG("->GetBattleInfo no info"); return ActionRequest::GetBattleInfo; }
+    if(++ticksSinceInfo_>=REFRESH_INTERVAL) { seenInfo_=false; ARENA_LOG_DEBUG("->GetBattleInfo refresh"); return ActionRequest::GetBattleInfo; }
+    if(algoCooldown_>0) { --algoCooldown_; curDir_=(curDir_+7)%8; ARENA_LOG_DEBUG("->RotateLeft45 cd"); return ActionRequest::RotateLeft45; }
+    if(plan_.empty()) { ARENA_LOG_DEBUG("computing plan"); computePlan(); }
     if(!plan_.empty()) {
         auto act=plan_.front(); plan_.pop_front();
-        std::cerr<<"DEBUG: act="<<static_cast<int>(act)<<"\n";
+        ARENA_LOG_DEBUG("act="<<static_cast<int>(act));
         switch(act) {
             case ActionRequest::RotateLeft45: curDir_=(curDir_+7)%8; break;
             case ActionRequest::RotateRight45: curDir_=(curDir_+1)%8; break;
@@ -46,85 +151,155 @@ common::ActionRequest AggressiveTank::getAction() {
         }
         return act;
     }
-    seenInfo_=false; std::cerr<<"DEBUG: ->GetBattleInfo fallback\n";
+    seenInfo_=false; ARENA_LOG_DEBUG("->GetBattleInfo fallback");
     return ActionRequest::GetBattleInfo;
 }
 
 void AggressiveTank::computePlan() {
-    std::cerr<<"DEBUG: computePlan pos=("<<curX_<<","<<curY_<<") dir="<<curDir_<<" shells="<<shellsLeft_<<"\n";
+    ARENA_LOG_DEBUG("computePlan pos=("<<curX_<<","<<curY_<<") dir="<<curDir_<<" shells="<<shellsLeft_);
+    if(lastInfo_.flow){ planFromFlow(); return; }
     int rows=(int)lastInfo_.rows, cols=(int)lastInfo_.cols;
-    int total=rows*cols*8;
+    std::size_t total=std::size_t(rows)*cols*8;
     const int INF=std::numeric_limits<int>::max();
-    std::vector<int> dist(total,INF), parent(total,-1);
-    std::vector<common::ActionRequest> via(total);
-    std::priority_queue<std::pair<int,int>,std::vector<std::pair<int,int>>,std::greater<>>pq;
+
+    PlanScratch& ps=planScratch();
+    constexpr int NB=std::max(ROTATE_COST,MOVE_COST)+1;
+    static_assert(ROTATE_COST>=1 && MOVE_COST>=1, "dial queue needs positive edge costs");
+    ps.begin(total);
+    ps.buckets.resize(NB);
+    auto distOf=[&](int s){ return ps.stamp[s]==ps.epoch ? ps.nodes[s].dist : INF; };
+
+    // Dial's queue: every edge costs 1..NB-1, so bucket t%NB
+    // only ever holds states of cost t while t is being expanded. Sorting a
+    // bucket before expanding it pops states in (cost, state) order, the same
+    // order a min-heap of (cost, state) pairs would.
+    std::size_t queued=0;
+    auto relax=[&](int v,int cost,int from,common::ActionRequest act){
+        if(cost<distOf(v)){
+            ps.stamp[v]=ps.epoch; ps.nodes[v]={cost,from,act};
+            ps.buckets[cost%NB].push_back(v); ++queued;
+        }
+    };
     int start=(curY_*cols+curX_)*8+curDir_;
-    dist[start]=0; pq.push({0,start});
+    relax(start,0,-1,ActionRequest::DoNothing);
     int bestU=-1, bestT=INF;
-    while(!pq.empty()){
-        auto [t,u]=pq.top(); pq.pop(); if(t>dist[u]) continue;
-        int ux=(u/8)%cols, uy=(u/8)/cols, ud=u%8;
-        int walls=0; bool vis=false;
-        int tx=ux, ty=uy;
-        while(true){ tx+=DX[ud]; ty+=DY[ud];
-            if(tx<0||tx>=cols||ty<0||ty>=rows) break;
-            char c=lastInfo_.grid[ty][tx];
-            if(c=='#'){ walls++; continue; } 
-            if(c!='.') {vis=true;break;}
-        }
-        if(vis){ int cost=(walls*2+1);
-            if(cost<=shellsLeft_){int tt=t+ROTATE_COST+1;
-                if(tt<bestT){bestT=tt; bestU=u;
-                    std::cerr<<"DEBUG: found u="<<u<<" t="<<tt<<" walls="<<walls<<"\n";}}
-            break;
-        }
-                // rotate 45° and 90°
-        for (auto delta : std::initializer_list<int>{-1, 1, -2, 2}) {
-            int nd = (ud + delta + 8) % 8;
-            int v = (uy * cols + ux) * 8 + nd;
-            int cost = t + ROTATE_COST;
-            if (cost < dist[v]) {
-                dist[v] = cost;
-                parent[v] = u;
-                common::ActionRequest act = (delta == -1
-                    ? ActionRequest::RotateLeft45
-                    : delta == 1
-                        ? ActionRequest::RotateRight45
-                        : delta == -2
-                            ? ActionRequest::RotateLeft90
-                            : ActionRequest::RotateRight90);
-                via[v] = act;
-                pq.push({cost, v});
+    bool done=false;
+    for(int t=0; queued>0 && !done; ++t){
+        auto& bucket=ps.buckets[t%NB];
+        if(bucket.empty()) continue;
+        ps.level.swap(bucket);
+        std::sort(ps.level.begin(),ps.level.end());
+        queued-=ps.level.size();
+        for(int u : ps.level){
+            if(t>distOf(u)) continue;
+            int ux=(u/8)%cols, uy=(u/8)/cols, ud=u%8;
+            int walls=rayWalls(lastInfo_,ps,ux,uy,ud);
+            if(walls!=PlanScratch::LOS_NONE){ int cost=(walls*2+1);
+                if(cost<=shellsLeft_){int tt=t+ROTATE_COST+1;
+                    if(tt<bestT){bestT=tt; bestU=u;
+                        ARENA_LOG_TRACE("found u="<<u<<" t="<<tt<<" walls="<<walls);}}
+                done=true;
+                break;
             }
+            // rotate 45° and 90°
+            for (auto delta : std::initializer_list<int>{-1, 1, -2, 2}) {
+                int nd = (ud + delta + 8) % 8;
+                int v = (uy * cols + ux) * 8 + nd;
+                relax(v, t + ROTATE_COST, u,
+                      delta == -1 ? ActionRequest::RotateLeft45
+                    : delta ==  1 ? ActionRequest::RotateRight45
+                    : delta == -2 ? ActionRequest::RotateLeft90
+                                  : ActionRequest::RotateRight90);
+            }
+            int fx = ux + DX[ud], fy = uy + DY[ud];
+            if(isTraversable(fx,fy))
+                relax((fy*cols+fx)*8+ud, t+MOVE_COST, u, ActionRequest::MoveForward);
         }
-        int fx = ux + DX[ud], fy = uy + DY[ud];
-        if(isTraversable(fx,fy)){
-            int v=(fy*cols+fx)*8+ud, ct=t+MOVE_COST;
-            if(ct<dist[v]){dist[v]=ct;parent[v]=u;via[v]=ActionRequest::MoveForward;pq.push({ct,v});}
-        }
+        ps.level.clear();
     }
-    if(bestU<0){std::cerr<<"DEBUG: no shoot state\n";return;}
+    for(auto& b : ps.buckets) b.clear();
+
+    if(bestU<0){ARENA_LOG_DEBUG("no shoot state");return;}
     std::vector<common::ActionRequest> seq;
-    for(int v=bestU;v!=start;v=parent[v]) seq.push_back(via[v]);
+    for(int v=bestU;v!=start;v=ps.nodes[v].parent) seq.push_back(ps.nodes[v].via);
     std::reverse(seq.begin(),seq.end());
-    std::cerr<<"DEBUG: seq:";
-    for(auto &a:seq) std::cerr<<" "<<static_cast<int>(a);
-    std::cerr<<"\n";
+    appendPlan(seq,(bestU/8)%cols,(bestU/8)/cols,bestU%8);
+}
+
+// The path plus the shots fired from where it ends.
+void AggressiveTank::appendPlan(const std::vector<common::ActionRequest>& seq, int x, int y, int dir){
+    ARENA_LOG_DEBUG("seq:"<<ActionList{seq});
     for(auto &a:seq) plan_.push_back(a);
     int ds, wh;
-    lineOfSight((bestU/8)%cols,(bestU/8)/cols,bestU%8,ds,wh);
-    std::cerr<<"DEBUG: shoot walls="<<wh<<" shots="<<(wh*2+1)<<"\n";
+    lineOfSight(x,y,dir,ds,wh);
+    ARENA_LOG_DEBUG("shoot walls="<<wh<<" shots="<<(wh*2+1));
     for(int i=0;i<wh*2;++i) plan_.push_back(ActionRequest::Shoot);
     plan_.push_back(ActionRequest::Shoot);
 }
 
+// Reads the plan off the player's FlowField instead of searching. Same
+// costs and shell check as computePlan(), but the field's board model is
+// its own (see FlowField.h): it walks blank cells and aims at enemy tanks.
+void AggressiveTank::planFromFlow(){
+    static_assert(FlowField::ROTATE_COST==ROTATE_COST && FlowField::MOVE_COST==MOVE_COST,
+                  "FlowField must price actions like the planner");
+    const FlowField& flow=*lastInfo_.flow;
+    int x=curX_, y=curY_, d=curDir_;
+    std::vector<common::ActionRequest> seq;
+    for(int left=flow.distance(x,y,d);;){
+        auto act=flow.next(x,y,d);
+        if(act==ActionRequest::Shoot) break;
+        if(act==ActionRequest::DoNothing || left--<=0){ ARENA_LOG_DEBUG("no shoot state"); return; }
+        seq.push_back(act);
+        switch(act){
+            case ActionRequest::RotateLeft45:  d=(d+7)%8; break;
+            case ActionRequest::RotateRight45: d=(d+1)%8; break;
+            case ActionRequest::RotateLeft90:  d=(d+6)%8; break;
+            case ActionRequest::RotateRight90: d=(d+2)%8; break;
+            default: x+=DX[d]; y+=DY[d]; break;   // MoveForward
+        }
+    }
+    if(flow.wallsAhead(x,y,d)*2+1>shellsLeft_){ ARENA_LOG_DEBUG("no shoot state"); return; }
+    appendPlan(seq,x,y,d);
+}
+
+// Incremental mode: replays the rest of plan_ on the fresh view. The plan
+// stands if every forward move still lands on a traversable cell and, at
+// the first shot, the ray still reaches a target we have the shells for.
+// Only the cells the plan crosses and its firing ray are read, so a view
+// that changed elsewhere costs O(plan + ray) instead of a new search.
+bool AggressiveTank::planStillValid(){
+    int rows=(int)lastInfo_.rows, cols=(int)lastInfo_.cols;
+    PlanScratch& ps=planScratch();
+    ps.begin(std::size_t(rows)*cols*8);
+    int x=curX_, y=curY_, d=curDir_;
+    int shots=0;
+    for(auto act : plan_){
+        switch(act){
+            case ActionRequest::RotateLeft45:  d=(d+7)%8; break;
+            case ActionRequest::RotateRight45: d=(d+1)%8; break;
+            case ActionRequest::RotateLeft90:  d=(d+6)%8; break;
+            case ActionRequest::RotateRight90: d=(d+2)%8; break;
+            case ActionRequest::MoveForward:
+                x+=DX[d]; y+=DY[d];
+                if(!isTraversable(x,y)) return false;
+                break;
+            case ActionRequest::Shoot:
+                if(shots++==0 && rayWalls(lastInfo_,ps,x,y,d)==PlanScratch::LOS_NONE) return false;
+                break;
+            default: return false;
+        }
+    }
+    return shots==0 || shots<=shellsLeft_;
+}
+
 bool AggressiveTank::lineOfSight(int sx,int sy,int dir,int& ds,int& wh) const{
     ds=wh=0;
     int rows=(int)lastInfo_.rows, cols=(int)lastInfo_.cols;
     int x=sx, y=sy;
     while(true){ x+=DX[dir]; y+=DY[dir]; ++ds;
         if(x<0||x>=cols||y<0||y>=rows) return false;
-        char c=lastInfo_.grid[y][x];
+        char c=lastInfo_.at(x,y);
         if(c=='#'){++wh;return false;}
         if(c!='.') return true;
     }
@@ -132,5 +307,50 @@ bool AggressiveTank::lineOfSight(int sx,int sy,int dir,int& ds,int& wh) const{
 
 bool AggressiveTank::isTraversable(int x,int y) const{
     int rows=(int)lastInfo_.rows, cols=(int)lastInfo_.cols;
-    return x>=0&&x<cols&&y>=0&&y<rows&&lastInfo_.grid[y][x]=='.';
+    return x>=0&&x<cols&&y>=0&&y<rows&&lastInfo_.at(x,y)=='.';
+}
+
+void AggressiveTank::saveState(CheckpointWriter& out) const {
+    lastInfo_.save(out);
+    out.putI(shellsLeft_);
+    out.putBool(seenInfo_);
+    out.putI(algoCooldown_);
+    out.putU(plan_.size());
+    for (auto act : plan_) out.putU(static_cast<std::uint64_t>(act));
+    out.putI(ticksSinceInfo_);
+    out.putI(curX_);
+    out.putI(curY_);
+    out.putI(curDir_);
+    out.putBool(lastInfo_.flow != nullptr);
+}
+
+// covers what saveState() writes
+std::uint64_t AggressiveTank::stateHash() const {
+    std::uint64_t h = lastInfo_.stateHash();
+    for (int v : {shellsLeft_, int(seenInfo_), algoCooldown_, ticksSinceInfo_, curX_, curY_, curDir_})
+        h = zobrist::combine(h, std::uint64_t(v));
+    h = zobrist::combine(h, plan_.size());
+    for (auto act : plan_) h = zobrist::combine(h, static_cast<std::uint64_t>(act));
+    return h;
+}
+
+bool AggressiveTank::loadState(CheckpointReader& in) {
+    lastInfo_.load(in);
+    shellsLeft_   = int(in.getI());
+    seenInfo_     = in.getBool();
+    algoCooldown_ = int(in.getI());
+    plan_.clear();
+    for (std::uint64_t n = in.getU(); n > 0 && in.ok(); --n)
+        plan_.push_back(static_cast<ActionRequest>(in.getU()));
+    ticksSinceInfo_ = int(in.getI());
+    curX_   = int(in.getI());
+    curY_   = int(in.getI());
+    curDir_ = int(in.getI());
+    if (in.getBool() && lastInfo_.snapshot) {
+        // the player's field is not saved; the same snapshot gives the same field
+        auto field = std::make_shared<FlowField>();
+        field->compute(*lastInfo_.snapshot, ownTank_);
+        lastInfo_.flow = std::move(field);
+    }
+    return in.ok();
 }
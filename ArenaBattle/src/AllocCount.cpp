@@ -0,0 +1,27 @@
+// src/AllocCount.cpp
+#include "AllocCount.h"
+
+#if ARENA_COUNT_ALLOCS
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+// per thread, so decision threads and parallel games do not count
+// against the thread that is checking
+thread_local std::uint64_t allocations = 0;
+}
+
+std::uint64_t arena::allocationCount() { return allocations; }
+
+// The other forms (array, nothrow) forward to these two by default.
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+#endif
@@ -0,0 +1,115 @@
+// src/BatchRunner.cpp
+#include "BatchRunner.h"
+#include "MyPlayerFactory.h"
+#include "MyTankAlgorithmFactory.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <ostream>
+#include <unordered_map>
+
+using namespace arena;
+namespace fs = std::filesystem;
+
+BatchRunner::BatchRunner(std::size_t threads, LogFormat format, bool stopCycles)
+  : threads_(threads), format_(format), stopCycles_(stopCycles)
+{}
+
+std::vector<std::string> BatchRunner::collectMaps(const std::vector<std::string>& paths) {
+    std::vector<std::string> maps;
+    for (const auto& p : paths) {
+        std::error_code ec;
+        if (fs::is_directory(p, ec)) {
+            std::vector<std::string> found;
+            for (const auto& entry : fs::directory_iterator(p, ec)) {
+                // output_*.txt are action logs from earlier runs, not maps
+                if (entry.is_regular_file() && entry.path().extension() == ".txt" &&
+                    !entry.path().filename().string().starts_with("output_"))
+                    found.push_back(entry.path().string());
+            }
+            std::sort(found.begin(), found.end());
+            maps.insert(maps.end(), found.begin(), found.end());
+        } else {
+            maps.push_back(p);
+        }
+    }
+    return maps;
+}
+
+static BatchResult playOne(const std::string& map_file, LogFormat format, bool stopCycles) {
+    BatchResult r;
+    r.map_file = map_file;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        GameManager gm(std::make_unique<MyPlayerFactory>(),
+                       std::make_unique<common::MyTankAlgorithmFactory>());
+        gm.setObserver(std::make_unique<NullObserver>());
+        gm.setLogFormat(format);
+        gm.setCycleDetection(stopCycles);
+        std::string error;
+        if (!gm.readBoard(map_file, error)) {
+            r.result = error;
+        } else if (!gm.run(error)) {
+            r.result = "error: " + error;
+        } else {
+            r.ok     = true;
+            r.result = gm.getGameState().getResultString();
+            r.turns  = gm.getGameState().getCurrentStep();
+        }
+    } catch (const std::exception& e) {
+        r.result = std::string("error: ") + e.what();
+    }
+    r.millis = std::chrono::duration<double, std::milli>(
+                   std::chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+std::vector<BatchResult> BatchRunner::run(const std::vector<std::string>& maps) const {
+    std::vector<BatchResult> results(maps.size());
+    // Logs go to output_<map name> in the working directory, so two maps
+    // with the same name (a/map.txt, b/map.txt) would write the same file
+    // at the same time. Only the first of them is played.
+    std::unordered_map<std::string, std::size_t> firstWithName;
+    ThreadPool pool(threads_);
+    for (std::size_t i = 0; i < maps.size(); ++i) {
+        auto [first, fresh] = firstWithName.emplace(GameManager::mapName(maps[i]), i);
+        if (!fresh) {
+            results[i].map_file = maps[i];
+            results[i].result   = "error: same output name as " + maps[first->second] +
+                                  ", not played";
+            continue;
+        }
+        pool.submit([&results, &maps, i, this] {
+            results[i] = playOne(maps[i], format_, stopCycles_);
+        });
+    }
+    pool.wait();
+    return results;
+}
+
+void BatchRunner::printSummary(std::ostream& out,
+                               const std::vector<BatchResult>& results,
+                               double wallMillis)
+{
+    std::size_t p1 = 0, p2 = 0, ties = 0, errors = 0, turns = 0;
+    double cpuMillis = 0.0;
+    out << std::fixed << std::setprecision(1);
+    for (const auto& r : results) {
+        out << r.map_file << ": " << r.result
+            << " (" << r.turns << " turns, " << r.millis << " ms)\n";
+        cpuMillis += r.millis;
+        turns     += r.turns;
+        if (!r.ok)                                 ++errors;
+        else if (r.result.rfind("Player 1", 0) == 0) ++p1;
+        else if (r.result.rfind("Player 2", 0) == 0) ++p2;
+        else                                       ++ties;
+    }
+    out << "=== Batch Summary ===\n"
+        << "games:   " << results.size() << " (" << errors << " failed)\n"
+        << "results: player1 " << p1 << ", player2 " << p2 << ", ties " << ties << "\n"
+        << "turns:   " << turns << "\n"
+        << "time:    " << wallMillis << " ms wall, " << cpuMillis << " ms summed\n";
+}
@@ -0,0 +1,43 @@
+// src/BattleChangeLog.cpp
+#include "BattleChangeLog.h"
+
+#include <algorithm>
+
+using namespace arena;
+
+void BattleChangeLog::reset(const BattleSnapshot& picture) {
+    rows_  = picture.rows;
+    cols_  = picture.cols;
+    cells_ = picture.cells;
+    log_.clear();
+    log_.reserve(cells_.size());   // its most, so set() never reallocates
+    base_ = 0;
+    hash_ = picture.hash;
+    cached_.reset();
+    cachedVersion_ = 0;
+}
+
+SnapshotPtr BattleChangeLog::snapshot() {
+    const std::uint64_t now = version();
+    if (cached_ && cachedVersion_ == now) return cached_;
+
+    if (cached_ && cached_.use_count() == 1 && cachedVersion_ >= base_) {
+        for (std::size_t i = std::size_t(cachedVersion_ - base_); i < log_.size(); ++i)
+            cached_->cells[log_[i]] = cells_[log_[i]];
+    } else {
+        cached_ = std::make_shared<BattleSnapshot>(rows_, cols_);
+        std::copy(cells_.begin(), cells_.end(), cached_->cells.begin());
+    }
+    cachedVersion_   = now;
+    cached_->version = now + 1;
+    cached_->hash    = hash_;
+    return cached_;
+}
+
+bool BattleChangeLog::changesSince(std::uint64_t since, std::vector<CellChange>& out) const {
+    if (since == NO_VIEW || since < base_ || since > version()) return false;
+    if (version() - since > cells_.size() / 8) return false;
+    for (std::size_t i = std::size_t(since - base_); i < log_.size(); ++i)
+        out.push_back({ log_[i], cells_[log_[i]] });
+    return true;
+}
@@ -3,14 +3,12 @@
 
 Board::Board(std::size_t rows, std::size_t cols)
   : rows_(rows), cols_(cols),
-    grid_(rows, std::vector<Cell>(cols))
+    cells_(rows * cols)
 {}
 
 void Board::setCell(int x, int y, CellContent c) {
-    Cell& cell = grid_[y][x];
-    cell.content         = c;
-    cell.wallHits        = (c == CellContent::WALL ? 0 : 0);
-    cell.hasShellOverlay = false;
+    Cell& cell = cells_[index(x, y)];
+    cell.bits = std::uint8_t(c);
 }
 
 void Board::wrapCoords(int& x, int& y) const {
@@ -18,9 +16,3 @@ void Board::wrapCoords(int& x, int& y) const {
     x = (x % w + w) % w;
     y = (y % h + h) % h;
 }
-
-void Board::clearShellMarks() {
-    for (auto& row : grid_)
-        for (auto& cell : row)
-            cell.hasShellOverlay = false;
-}
@@ -0,0 +1,102 @@
+// src/CellChars.cpp
+#include "CellChars.h"
+
+#include <cstdint>
+
+#if ARENA_SIMD && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ARENA_CELLCHARS_X86 1
+#include <immintrin.h>
+#else
+#define ARENA_CELLCHARS_X86 0
+#endif
+
+using namespace arena;
+
+namespace {
+
+using Kernel = void (*)(const std::uint8_t*, std::size_t, char*, const CellCharTable&);
+
+void scalarKernel(const std::uint8_t* in, std::size_t n, char* out, const CellCharTable& t) {
+    for (std::size_t i = 0; i < n; ++i) out[i] = cellChar(Cell{in[i]}, t);
+}
+
+#if ARENA_CELLCHARS_X86
+// Both kernels: chars = table[bits & 7] by byte shuffle, then where the
+// cell is EMPTY with the shell bit (bits & 0x27 == 0x20) blend in t.shell.
+
+__attribute__((target("sse4.1")))
+void sse41Kernel(const std::uint8_t* in, std::size_t n, char* out, const CellCharTable& t) {
+    std::uint8_t table[16] = {};
+    for (int i = 0; i < 8; ++i) table[i] = std::uint8_t(t.content[i]);
+    const __m128i lut     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+    const __m128i content = _mm_set1_epi8(Cell::CONTENT_MASK);
+    const __m128i probe   = _mm_set1_epi8(char(Cell::SHELL_BIT | Cell::CONTENT_MASK));
+    const __m128i shellOn = _mm_set1_epi8(char(Cell::SHELL_BIT));
+    const __m128i shell   = _mm_set1_epi8(t.shell);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i c = _mm_shuffle_epi8(lut, _mm_and_si128(v, content));
+        if (t.shell)
+            c = _mm_blendv_epi8(c, shell, _mm_cmpeq_epi8(_mm_and_si128(v, probe), shellOn));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), c);
+    }
+    scalarKernel(in + i, n - i, out + i, t);
+}
+
+__attribute__((target("avx2")))
+void avx2Kernel(const std::uint8_t* in, std::size_t n, char* out, const CellCharTable& t) {
+    std::uint8_t table[16] = {};
+    for (int i = 0; i < 8; ++i) table[i] = std::uint8_t(t.content[i]);
+    // the shuffle looks up within each 128-bit lane, so both get the table
+    const __m256i lut = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+    const __m256i content = _mm256_set1_epi8(Cell::CONTENT_MASK);
+    const __m256i probe   = _mm256_set1_epi8(char(Cell::SHELL_BIT | Cell::CONTENT_MASK));
+    const __m256i shellOn = _mm256_set1_epi8(char(Cell::SHELL_BIT));
+    const __m256i shell   = _mm256_set1_epi8(t.shell);
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        __m256i c = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, content));
+        if (t.shell)
+            c = _mm256_blendv_epi8(c, shell, _mm256_cmpeq_epi8(_mm256_and_si256(v, probe), shellOn));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), c);
+    }
+    sse41Kernel(in + i, n - i, out + i, t);
+}
+#endif
+
+struct Dispatch {
+    Kernel      kernel = scalarKernel;
+    const char* name   = "scalar";
+
+    Dispatch() {
+#if ARENA_CELLCHARS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            kernel = avx2Kernel;
+            name   = "avx2";
+        } else if (__builtin_cpu_supports("sse4.1")) {
+            kernel = sse41Kernel;
+            name   = "sse4.1";
+        }
+#endif
+    }
+};
+
+const Dispatch& dispatch() {
+    static const Dispatch d;
+    return d;
+}
+
+} // namespace
+
+void arena::cellsToChars(const Cell* cells, std::size_t n, char* out, const CellCharTable& t) {
+    // Cell is one byte (see Board.h), so a row is a plain byte array
+    dispatch().kernel(reinterpret_cast<const std::uint8_t*>(cells), n, out, t);
+}
+
+const char* arena::cellCharsKernel() {
+    return dispatch().name;
+}
@@ -0,0 +1,98 @@
+// src/Checkpoint.cpp
+#include "Checkpoint.h"
+
+#include <cstring>
+
+using namespace arena;
+
+void CheckpointWriter::putU(std::uint64_t v) {
+    while (v >= 0x80) {
+        buf_.push_back(char((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    buf_.push_back(char(v));
+}
+
+void CheckpointWriter::putBytes(const void* data, std::size_t n) {
+    const char* p = static_cast<const char*>(data);
+    buf_.insert(buf_.end(), p, p + n);
+}
+
+void CheckpointWriter::putString(const std::string& s) {
+    putU(s.size());
+    putBytes(s.data(), s.size());
+}
+
+// 0 = null, 1 = new snapshot follows, 2 + id = already written
+void CheckpointWriter::putSnapshot(const SnapshotPtr& snap) {
+    if (!snap) {
+        putU(0);
+        return;
+    }
+    auto it = snapIds_.find(snap.get());
+    if (it != snapIds_.end()) {
+        putU(2 + it->second);
+        return;
+    }
+    snapIds_.emplace(snap.get(), snapIds_.size());
+    putU(1);
+    putU(snap->rows);
+    putU(snap->cols);
+    putBytes(snap->cells.data(), snap->cells.size());
+}
+
+//------------------------------------------------------------------------------
+std::uint64_t CheckpointReader::getU() {
+    std::uint64_t v = 0;
+    for (unsigned shift = 0; !failed_ && shift < 64; shift += 7) {
+        if (cur_ == end_) break;
+        unsigned char c = static_cast<unsigned char>(*cur_++);
+        v |= std::uint64_t(c & 0x7F) << shift;
+        if (!(c & 0x80)) return v;
+    }
+    failed_ = true;
+    return 0;
+}
+
+bool CheckpointReader::getBytes(void* out, std::size_t n) {
+    if (failed_ || std::size_t(end_ - cur_) < n) {
+        failed_ = true;
+        return false;
+    }
+    if (n) std::memcpy(out, cur_, n);
+    cur_ += n;
+    return true;
+}
+
+std::string CheckpointReader::getString() {
+    std::uint64_t n = getU();
+    if (failed_ || std::uint64_t(end_ - cur_) < n) {
+        failed_ = true;
+        return {};
+    }
+    std::string s(cur_, cur_ + n);
+    cur_ += n;
+    return s;
+}
+
+SnapshotPtr CheckpointReader::getSnapshot() {
+    std::uint64_t tag = getU();
+    if (failed_ || tag == 0) return nullptr;
+    if (tag >= 2) {
+        if (tag - 2 >= snaps_.size()) {
+            failed_ = true;
+            return nullptr;
+        }
+        return snaps_[tag - 2];
+    }
+    std::uint64_t rows = getU(), cols = getU();
+    if (failed_ || (cols && rows > std::uint64_t(end_ - cur_) / cols)) {
+        failed_ = true;
+        return nullptr;
+    }
+    auto snap = std::make_shared<BattleSnapshot>(rows, cols);
+    if (!getBytes(snap->cells.data(), snap->cells.size())) return nullptr;
+    snap->hash = zobrist::pictureHash(snap->cells.data(), snap->cells.size());
+    snaps_.push_back(snap);
+    return snap;
+}
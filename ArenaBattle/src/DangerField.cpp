@@ -0,0 +1,43 @@
+// src/DangerField.cpp
+#include "DangerField.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace arena;
+
+namespace {
+constexpr int DX[8] = { 0, +1, +1, +1,  0, -1, -1, -1 };
+constexpr int DY[8] = { -1,-1,  0, +1, +1, +1,  0, -1 };
+}
+
+void DangerField::compute(const BattleSnapshot& snap, int horizon) {
+    rows_ = snap.rows;
+    cols_ = snap.cols;
+    earliest_.clear();
+    horizon = std::clamp(horizon, 1, int(NONE) - 1);
+
+    const char* cells = snap.cells.data();
+    const std::size_t total = snap.cells.size();
+    const int R = int(rows_), C = int(cols_);
+    for (const char* p = cells;
+         (p = static_cast<const char*>(std::memchr(p, '*', total - std::size_t(p - cells))));
+         ++p)
+    {
+        if (earliest_.empty()) earliest_.assign(total, NONE);
+        const int sx = int(std::size_t(p - cells) % cols_);
+        const int sy = int(std::size_t(p - cells) / cols_);
+        for (int d = 0; d < 8; ++d) {
+            int x = sx, y = sy;
+            for (int step = 1; step <= 2 * horizon; ++step) {
+                x = (x + DX[d] + C) % C;
+                y = (y + DY[d] + R) % R;
+                const std::size_t i = std::size_t(y) * cols_ + std::size_t(x);
+                const auto tick = std::uint8_t((step + 1) / 2);
+                if (tick < earliest_[i]) earliest_[i] = tick;
+                const char c = cells[i];
+                if (c == '#' || c == '1' || c == '2' || c == '%') break;
+            }
+        }
+    }
+}
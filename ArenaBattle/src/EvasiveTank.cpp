@@ -1,7 +1,6 @@
 // src/EvasiveTank.cpp
 #include "EvasiveTank.h"
 #include "common/ActionRequest.h"
-#include <limits>
 #include <queue>
 
 using namespace arena;
@@ -15,16 +14,21 @@ EvasiveTank::EvasiveTank(int playerIndex, int /*tankIndex*/)
 {}
 
 void EvasiveTank::updateBattleInfo(BattleInfo& baseInfo) {
-    lastInfo_ = static_cast<MyBattleInfo&>(baseInfo);
+    lastInfo_.merge(static_cast<MyBattleInfo&>(baseInfo));
     if (shellsLeft_ < 0) {
         shellsLeft_ = int(lastInfo_.shellsRemaining);
     }
 }
 
+int EvasiveTank::dangerAt(int x, int y) const {
+    return lastInfo_.danger ? lastInfo_.danger->at(std::size_t(x), std::size_t(y))
+                            : DangerField::NONE;
+}
+
 bool EvasiveTank::isFree(int x, int y) const {
     if (x < 0 || x >= int(lastInfo_.cols) ||
         y < 0 || y >= int(lastInfo_.rows)) return false;
-    char c = lastInfo_.grid[y][x];
+    char c = lastInfo_.at(x, y);
     return c != '#' && c != '@' && c != '1' && c != '2';
 }
 
@@ -34,46 +38,23 @@ ActionRequest EvasiveTank::getAction() {
         needView_ = false;
         return ActionRequest::GetBattleInfo;
     }
+    if (!lastInfo_.selfKnown) return ActionRequest::GetBattleInfo;   // view had no '%'
     needView_ = true;
 
     int sx = int(lastInfo_.selfX);
     int sy = int(lastInfo_.selfY);
-    int R  = int(lastInfo_.rows);
-    int C  = int(lastInfo_.cols);
 
-    // (2) scan for any shell '*' up to two steps away
-    struct Threat { int dir, dist; };
-    std::vector<Threat> threats;
-    for (int d = 0; d < 8; ++d) {
-        int dx = DX[d], dy = DY[d];
-        for (int step = 1; step <= 2; ++step) {
-            int nx = sx + dx*step;
-            int ny = sy + dy*step;
-            if (nx<0||nx>=C||ny<0||ny>=R) break;
-            if (lastInfo_.grid[ny][nx] == '*') {
-                threats.push_back({d, step});
-                break;
-            }
-        }
-    }
-    if (!threats.empty()) {
-        // (3) find best escape direction: maximize distance from nearest threat
-        int bestDir=-1, bestMinDist=-1;
+    // (2) can a shell reach us next tick? (player's danger field)
+    if (dangerAt(sx, sy) <= 1) {
+        // (3) find best escape direction: the free neighbour shells reach last
+        int bestDir=-1, bestTick=-1;
         for (int cand = 0; cand < 8; ++cand) {
-            int dx = DX[cand], dy = DY[cand];
-            int x1 = sx+dx, y1=sy+dy;
+            int x1 = sx+DX[cand], y1=sy+DY[cand];
             if (!isFree(x1,y1)) continue;
-            // compute minimal projection of all threats onto this dir
-            int minDist = std::numeric_limits<int>::max();
-            for (auto& t : threats) {
-                // project threat vector onto cand
-                int proj = t.dist * (DX[t.dir]*dx + DY[t.dir]*dy);
-                // use absolute or just treat any non-positive as close
-                minDist = std::min(minDist, proj>0 ? proj : 0);
-            }
-            if (minDist > bestMinDist) {
-                bestMinDist = minDist;
-                bestDir     = cand;
+            int tick = dangerAt(x1, y1);
+            if (tick > bestTick) {
+                bestTick = tick;
+                bestDir  = cand;
             }
         }
         if (bestDir >= 0) {
@@ -95,7 +76,9 @@ ActionRequest EvasiveTank::getAction() {
                 direction_ = (direction_+6)&7;
                 return ActionRequest::RotateLeft90;
             }
-            // if already facing roughly, just move backward
+            // already facing it: step out forward
+            if (diff==0) return ActionRequest::MoveForward;
+            // facing roughly away, just move backward
             return ActionRequest::MoveBackward;
         }
     }
@@ -124,3 +107,31 @@ ActionRequest EvasiveTank::getAction() {
     // (5) default: move forward
     return ActionRequest::MoveForward;
 }
+
+void EvasiveTank::saveState(CheckpointWriter& out) const {
+    lastInfo_.save(out);
+    out.putI(direction_);
+    out.putI(shellsLeft_);
+    out.putBool(needView_);
+}
+
+std::uint64_t EvasiveTank::stateHash() const {
+    std::uint64_t h = lastInfo_.stateHash();
+    h = zobrist::combine(h, std::uint64_t(direction_));
+    h = zobrist::combine(h, std::uint64_t(shellsLeft_));
+    return zobrist::combine(h, needView_);
+}
+
+bool EvasiveTank::loadState(CheckpointReader& in) {
+    lastInfo_.load(in);
+    if (lastInfo_.snapshot) {
+        // the player's field is not saved; the same snapshot gives the same field
+        auto field = std::make_shared<DangerField>();
+        field->compute(*lastInfo_.snapshot);
+        lastInfo_.danger = std::move(field);
+    }
+    direction_  = int(in.getI());
+    shellsLeft_ = int(in.getI());
+    needView_   = in.getBool();
+    return in.ok();
+}
@@ -0,0 +1,121 @@
+// src/FlowField.cpp
+#include "FlowField.h"
+
+#include <algorithm>
+
+using namespace arena;
+using common::ActionRequest;
+
+namespace {
+constexpr int DX[8] = {0,1,1,1,0,-1,-1,-1};
+constexpr int DY[8] = {-1,-1,0,1,1,1,0,-1};
+
+constexpr int           TURNS[4]   = { -1, 1, -2, 2 };
+constexpr ActionRequest TURN_ACT[4] = { ActionRequest::RotateLeft45,  ActionRequest::RotateRight45,
+                                        ActionRequest::RotateLeft90,  ActionRequest::RotateRight90 };
+
+bool isTank(char c) { return c == '1' || c == '2'; }
+}
+
+void FlowField::compute(const BattleSnapshot& snap, char own) {
+    rows_ = snap.rows;
+    cols_ = snap.cols;
+    const int R = int(rows_), C = int(cols_);
+    const std::size_t cells = rows_ * cols_;
+
+    kind_.resize(cells);
+    std::size_t pending = 0;   // states of own cells not yet final
+    for (std::size_t i = 0; i < cells; ++i) {
+        const char c = snap.cells[i];
+        kind_[i] = c == '#' || c == '@' || isTank(c) ? BLOCKED : OPEN;
+        if (own != 0 && c == own) { kind_[i] = OWN; pending += 8; }
+    }
+
+    // Backwards search from every firing position. Costs are 1..NB-1, so
+    // a dial queue with NB buckets holds each pending cost exactly once.
+    constexpr int NB = std::max(ROTATE_COST, MOVE_COST) + 1;
+    static_assert(ROTATE_COST >= 1 && MOVE_COST >= 1, "dial queue needs positive edge costs");
+    buckets_.resize(NB);
+    for (auto& b : buckets_) b.clear();   // an early stop leaves some behind
+    std::size_t queued = 0;
+
+    // Walls ahead, one direction at a time: a ray's answer is its next
+    // cell's answer, so visit cells so that the next cell comes first.
+    // Every state is written here, firing positions queued as they show up.
+    walls_.resize(cells * 8);
+    dist_.resize(cells * 8);
+    for (int d = 0; d < 8; ++d) {
+        for (int j = 0; j < R; ++j) {
+            const int y = DY[d] > 0 ? R - 1 - j : j;
+            for (int i = 0; i < C; ++i) {
+                const int x = DX[d] > 0 ? C - 1 - i : i;
+                const int nx = x + DX[d], ny = y + DY[d];
+                std::uint16_t w = NO_TARGET;
+                if (nx >= 0 && nx < C && ny >= 0 && ny < R) {
+                    const char c = snap.cells[std::size_t(ny) * cols_ + std::size_t(nx)];
+                    w = 0;
+                    if (c == '#') {
+                        w = walls_[state(nx, ny, d)];
+                        if (w != NO_TARGET && w + 1 < NO_TARGET) ++w;
+                    } else if (isTank(c)) {
+                        if (c == own) w = NO_TARGET;   // our own tank takes the shot
+                    } else {
+                        w = walls_[state(nx, ny, d)];
+                    }
+                }
+                const std::size_t s = state(x, y, d);
+                walls_[s] = w;
+                if (w == NO_TARGET) {
+                    dist_[s] = UNREACHABLE;
+                } else {
+                    dist_[s] = 0;
+                    buckets_[0].push_back(std::uint32_t(s));
+                    ++queued;
+                }
+            }
+        }
+    }
+
+    auto relax = [&](std::size_t s, int cost) {
+        if (cost >= UNREACHABLE) cost = UNREACHABLE - 1;
+        if (cost < dist_[s]) {
+            dist_[s] = std::uint16_t(cost);
+            buckets_[std::size_t(cost) % NB].push_back(std::uint32_t(s));
+            ++queued;
+        }
+    };
+    std::vector<std::uint32_t> level;
+    for (int t = 0; queued > 0; ++t) {
+        level.swap(buckets_[std::size_t(t) % NB]);
+        queued -= level.size();
+        for (std::uint32_t s : level) {
+            if (dist_[s] != t) continue;   // improved since queued
+            const int cell = int(s / 8), d = int(s % 8);
+            const int x = cell % C, y = cell / C;
+            if (kind_[std::size_t(cell)] == OWN) --pending;
+            // a rotation by TURNS[k] from (d - TURNS[k]) lands here
+            for (int turn : TURNS)
+                relax(state(x, y, (d - turn + 8) % 8), t + ROTATE_COST);
+            // a forward move from the cell behind, if this cell can be entered
+            const int px = x - DX[d], py = y - DY[d];
+            if (kind_[std::size_t(cell)] == OPEN && px >= 0 && px < C && py >= 0 && py < R)
+                relax(state(px, py, d), t + MOVE_COST);
+        }
+        level.clear();
+        if (own != 0 && pending == 0) break;
+    }
+}
+
+ActionRequest FlowField::next(int x, int y, int dir) const {
+    const std::uint16_t here = dist_[state(x, y, dir)];
+    if (here == UNREACHABLE) return ActionRequest::DoNothing;
+    if (here == 0)           return ActionRequest::Shoot;
+    for (int k = 0; k < 4; ++k)
+        if (dist_[state(x, y, (dir + TURNS[k] + 8) % 8)] + ROTATE_COST == here) return TURN_ACT[k];
+    const int fx = x + DX[dir], fy = y + DY[dir];
+    if (fx >= 0 && fx < int(cols_) && fy >= 0 && fy < int(rows_) &&
+        kind_[std::size_t(fy) * cols_ + std::size_t(fx)] == OPEN &&
+        dist_[state(fx, fy, dir)] + MOVE_COST == here)
+        return ActionRequest::MoveForward;
+    return ActionRequest::DoNothing;   // only past the saturation limit
+}
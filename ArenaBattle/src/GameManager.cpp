@@ -1,134 +1,164 @@
 #include "GameManager.h"
 #include "Board.h"
+#include "MapLoader.h"
+#include "Replay.h"
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 
 using namespace arena;
 
 GameManager::GameManager(std::unique_ptr<common::PlayerFactory>        pFac,
                          std::unique_ptr<common::TankAlgorithmFactory> tFac)
-  : game_state_(std::move(pFac), std::move(tFac))
+  : game_state_(std::move(pFac), std::move(tFac)),
+    observer_(std::make_unique<ConsoleObserver>())
 {}
 
-void GameManager::readBoard(const std::string& map_file) {
+void GameManager::setObserver(std::unique_ptr<GameObserver> observer) {
+    observer_ = observer ? std::move(observer) : std::make_unique<NullObserver>();
+}
+
+void GameManager::setLogFormat(LogFormat format) {
+    log_format_ = format;
+}
+
+bool GameManager::readBoard(const std::string& map_file, std::string& error) {
+    MapData map;
+    if (!loadMap(map_file, map, error)) return false;
+
     loaded_map_file_ = map_file;
+    game_state_.initialize(std::move(map.board), map.maxSteps, map.numShells);
+    return true;
+}
+
+bool GameManager::saveCheckpoint(const std::string& path, std::string& error) const {
+    CheckpointWriter out;
+    out.putBytes(CHECKPOINT_MAGIC, sizeof CHECKPOINT_MAGIC);
+    out.putU(CHECKPOINT_VERSION);
+    out.putString(loaded_map_file_);
+    game_state_.saveCheckpoint(out);
 
-    std::ifstream in(map_file);
-    if (!in) {
-        std::cerr << "Failed to open map file: " << map_file << "\n";
-        std::exit(1);
+    std::ofstream ofs(path, std::ios::out | std::ios::binary);
+    ofs.write(out.data().data(), std::streamsize(out.data().size()));
+    if (!ofs) {
+        error = "cannot write " + path;
+        return false;
     }
+    return true;
+}
 
-    size_t rows = 0, cols = 0, maxSteps = 0, numShells = 0;
-    std::vector<std::string> gridLines;
-    std::string line;
-
-    // Parse header
-    while (std::getline(in, line)) {
-        if (line.rfind("Rows", 0) == 0) {
-            rows = std::stoul(line.substr(line.find('=') + 1));
-        } else if (line.rfind("Cols", 0) == 0) {
-            cols = std::stoul(line.substr(line.find('=') + 1));
-        } else if (line.rfind("MaxSteps", 0) == 0) {
-            maxSteps = std::stoul(line.substr(line.find('=') + 1));
-        } else if (line.rfind("NumShells", 0) == 0) {
-            numShells = std::stoul(line.substr(line.find('=') + 1));
-        } else {
-            // first grid line?
-            bool isGrid = !line.empty();
-            for (char ch : line) {
-                if (ch != '.' && ch != '#' && ch != '@' && ch != '1' && ch != '2') {
-                    isGrid = false;
-                    break;
-                }
-            }
-            if (isGrid) {
-                gridLines.push_back(line);
-                break;
-            }
-        }
+bool GameManager::loadCheckpoint(const std::string& path, std::string& error) {
+    std::ifstream ifs(path, std::ios::in | std::ios::binary);
+    if (!ifs) {
+        error = "cannot open " + path;
+        return false;
     }
-    // Read remaining grid rows
-    while (gridLines.size() < rows && std::getline(in, line)) {
-        if (line.empty()) continue;
-        bool isGrid = true;
-        for (char ch : line) {
-            if (ch != '.' && ch != '#' && ch != '@' && ch != '1' && ch != '2') {
-                isGrid = false;
-                break;
-            }
-        }
-        if (isGrid) gridLines.push_back(line);
+    std::vector<char> data((std::istreambuf_iterator<char>(ifs)),
+                           std::istreambuf_iterator<char>());
+
+    CheckpointReader in(data.data(), data.size());
+    char magic[sizeof CHECKPOINT_MAGIC];
+    if (!in.getBytes(magic, sizeof magic) ||
+        std::memcmp(magic, CHECKPOINT_MAGIC, sizeof magic) != 0) {
+        error = path + " is not a checkpoint file";
+        return false;
     }
-
-    // Build board
-    Board board(rows, cols);
-    for (size_t r = 0; r < rows; ++r) {
-        const auto& rowStr = gridLines[r];
-        for (size_t c = 0; c < cols && c < rowStr.size(); ++c) {
-            char ch = rowStr[c];
-            switch (ch) {
-                case '#': board.setCell(c, r, CellContent::WALL);  break;
-                case '@': board.setCell(c, r, CellContent::MINE);  break;
-                case '1': board.setCell(c, r, CellContent::TANK1); break;
-                case '2': board.setCell(c, r, CellContent::TANK2); break;
-                default:  board.setCell(c, r, CellContent::EMPTY);break;
-            }
-        }
+    std::uint64_t version = in.getU();
+    if (version != CHECKPOINT_VERSION) {
+        error = "unsupported checkpoint version " + std::to_string(version);
+        return false;
     }
+    loaded_map_file_ = in.getString();
+    if (!game_state_.loadCheckpoint(in, error)) return false;
+    if (!in.atEnd()) {
+        error = "trailing data after checkpoint";
+        return false;
+    }
+    return true;
+}
+
+static void writeProfile(const PhaseTimes& profile, const std::string& path) {
+    std::ofstream out(path);
+    const bool csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    if (csv) profile.writeCsv(out);
+    else     profile.writeJson(out);
+    if (!out)
+        std::cerr << "Error: cannot write profile '" << path << "'.\n";
+}
 
-    // Initialize the game
-    game_state_.initialize(board, maxSteps, numShells);
+std::string GameManager::mapName(const std::string& map_file) {
+    // Extract just the filename (no path)
+    std::string name = map_file;
+    auto slash = name.find_last_of("/\\");
+    if (slash != std::string::npos) name = name.substr(slash + 1);
+    // Strip extension
+    auto dot = name.rfind('.');
+    if (dot != std::string::npos) name = name.substr(0, dot);
+    return name;
 }
 
-void GameManager::run() {
+bool GameManager::run(std::string& error) {
     // Derive an output filename: e.g. "basic.txt" -> "output_basic.txt"
-    std::string outFile;
-    {
-        // Extract just the filename (no path)
-        std::string name = loaded_map_file_;
-        auto slash = name.find_last_of("/\\");
-        if (slash != std::string::npos) name = name.substr(slash + 1);
-        // Strip extension
-        auto dot = name.rfind('.');
-        if (dot != std::string::npos) name = name.substr(0, dot);
-        // Prefix
-        outFile = "output_" + name + ".txt";
-    }
+    const std::string name    = mapName(loaded_map_file_);
+    const std::string outFile = "output_" + name +
+                                (log_format_ == LogFormat::Replay ? ".replay" : ".txt");
 
-    std::ofstream ofs(outFile);
+    std::ofstream ofs(outFile, log_format_ == LogFormat::Replay
+                                 ? std::ios::out | std::ios::binary
+                                 : std::ios::out);
     if (!ofs) {
-        std::cerr << "Error: cannot open actions log file '"
-                  << outFile << "' for writing.\n";
-        std::exit(1);
+        error = "cannot open actions log file '" + outFile + "' for writing";
+        return false;
+    }
+
+    std::unique_ptr<ActionLog> log;
+    if (log_format_ == LogFormat::Replay) {
+        ReplayHeader header;
+        header.map_name   = name;
+        header.rows       = game_state_.getRows();
+        header.cols       = game_state_.getCols();
+        header.max_steps  = game_state_.getMaxSteps();
+        header.num_shells = game_state_.getNumShells();
+        header.tank_count = game_state_.getTankCount();
+        log = std::make_unique<ReplayWriter>(ofs, header);
+    } else {
+        log = std::make_unique<TextActionLog>(ofs);
     }
 
-    // 1) Print initial board to console
-    std::cout << "=== Start Position ===\n";
-    game_state_.printBoard();
+    PhaseTimes profile;
+    if (!profile_file_.empty()) game_state_.setPhaseTimes(&profile);
+
+    // 1) Initial position
+    observer_->onGameStart(game_state_);
 
-    std::size_t turn = 1;
+    std::size_t turn = game_state_.getCurrentStep() + 1;
     while (!game_state_.isGameOver()) {
-        // a) Print board
-        std::cout << "=== Turn " << turn << " ===\n";
-        // b) Advance and capture actions
-        std::string actions = game_state_.advanceOneTurn();
-        game_state_.printBoard();
-        // c) Log actions to file
-        ofs << actions << "\n";
+        // a) Advance one turn
+        game_state_.playOneTurn();
+        // b) Log actions to file
+        log->writeTurn(game_state_.lastOutcomes());
+        // c) Let the observer render/print the turn
+        observer_->onTurnEnd(turn, game_state_);
+        // d) Checkpoint if requested
+        if (turn == checkpoint_turn_) {
+            std::string error;
+            if (!saveCheckpoint(checkpoint_file_, error))
+                std::cerr << "Error: checkpoint failed: " << error << "\n";
+        }
         ++turn;
     }
 
-    // Final board + result on console
-    std::cout << "=== Final Board ===\n";
-    game_state_.printBoard();
-    std::string result = game_state_.getResultString();
-    std::cout << result << "\n";
-
-    // And log the final result line
-    ofs << result << "\n";
+    // Log the final result line
+    log->writeResult(game_state_.getResultString());
     ofs.close();
 
-    std::cout << "Actions logged to: " << outFile << "\n";
+    if (!profile_file_.empty()) {
+        game_state_.setPhaseTimes(nullptr);
+        writeProfile(profile, profile_file_);
+    }
+
+    observer_->onGameEnd(game_state_, outFile);
+    return true;
 }
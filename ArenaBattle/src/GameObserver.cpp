@@ -0,0 +1,46 @@
+// src/GameObserver.cpp
+#include "GameObserver.h"
+#include "GameState.h"
+#include "utils.h"
+
+#include <iostream>
+
+using namespace arena;
+
+ConsoleObserver::ConsoleObserver() : out_(std::cout) {}
+
+void ConsoleObserver::onGameStart(const GameState& state) {
+    out_ << "=== Start Position ===\n";
+    state.printBoard(out_);
+    out_.flush();
+}
+
+void ConsoleObserver::onTurnEnd(std::size_t turn, const GameState& state) {
+    out_ << "=== Turn " << turn << " ===\n";
+
+    // each tank's decision and status
+    out_ << "=== Decisions ===\n\n";
+    const auto& requests = state.lastRequests();
+    const auto& ignored  = state.lastIgnored();
+    for (std::size_t k = 0; k < requests.size(); ++k) {
+        bool wasIgnored = ignored[k]
+            && requests[k] != common::ActionRequest::GetBattleInfo;
+        out_ << "  Tank[" << k << "]: "
+             << actionToString(requests[k])
+             << (wasIgnored ? " (ignored)" : " (accepted)")
+             << "\n";
+    }
+    out_ << "\n";
+    out_ << "=== Board State: ===\n\n";
+
+    state.printBoard(out_);
+    out_.flush();
+}
+
+void ConsoleObserver::onGameEnd(const GameState& state, const std::string& logFile) {
+    out_ << "=== Final Board ===\n";
+    state.printBoard(out_);
+    out_ << state.getResultString() << "\n";
+    out_ << "Actions logged to: " << logFile << "\n";
+    out_.flush();
+}
@@ -1,25 +1,17 @@
 #include "GameState.h"
+#include "AllocCount.h"
 #include "Board.h"
+#include "CellChars.h"
 #include "MyBattleInfo.h"
+#include "ConcurrentPlayer.h"
+#include "DeltaViewer.h"
 // #include "utils.h"
-#include <iostream>
-#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <ostream>
 
 
-static const char* actionToString(common::ActionRequest a) {
-    switch (a) {
-      case common::ActionRequest::MoveForward:    return "MoveForward";
-      case common::ActionRequest::MoveBackward:   return "MoveBackward";
-      case common::ActionRequest::RotateLeft90:   return "RotateLeft90";
-      case common::ActionRequest::RotateRight90:  return "RotateRight90";
-      case common::ActionRequest::RotateLeft45:   return "RotateLeft45";
-      case common::ActionRequest::RotateRight45:  return "RotateRight45";
-      case common::ActionRequest::Shoot:          return "Shoot";
-      case common::ActionRequest::GetBattleInfo:  return "GetBattleInfo";
-      default:                                    return "DoNothing";
-    }
-}
-
 using namespace arena;
 using namespace common;
 
@@ -33,102 +25,437 @@ GameState::GameState(std::unique_ptr<common::PlayerFactory> pFac,
 GameState::~GameState() = default;
 
 //------------------------------------------------------------------------------
-void GameState::initialize(const Board& board,
+void GameState::initialize(Board board,
                            std::size_t maxSteps,
                            std::size_t numShells)
 {
-    board_      = board;
-    rows_       = board.getRows();
-    cols_       = board.getCols();
+    board_      = std::move(board);
+    rows_       = board_.getRows();
+    cols_       = board_.getCols();
     maxSteps_   = maxSteps;
     num_shells_ = numShells;
 
     all_tanks_.clear();
-    tankIdMap_.assign(3, std::vector<std::size_t>(rows_*cols_, SIZE_MAX));
+    tankIdMap_.assign(3, {});
     nextTankIndex_[1] = nextTankIndex_[2] = 0;
 
     for (std::size_t r = 0; r < rows_; ++r) {
+        const Cell* row = board_.row(r);
         for (std::size_t c = 0; c < cols_; ++c) {
-            const Cell& cell = board_.getCell(int(c), int(r));
-            if (cell.content == CellContent::TANK1 ||
-                cell.content == CellContent::TANK2)
+            const CellContent content = row[c].content();
+            if (content == CellContent::TANK1 ||
+                content == CellContent::TANK2)
             {
-                int pidx = (cell.content==CellContent::TANK1?1:2);
+                int pidx = (content==CellContent::TANK1?1:2);
                 int tidx = nextTankIndex_[pidx]++;
                 TankState ts{pidx,tidx,int(c),int(r),(pidx==1?6:2),true,num_shells_,0,0,false};
                 
                 all_tanks_.push_back(ts);
-                tankIdMap_[pidx][tidx] = all_tanks_.size()-1;
+                tankIdMap_[pidx].push_back(all_tanks_.size()-1);
             }
         }
     }
+    tankAtCell_.clear(all_tanks_.size());
+    for (std::size_t k = 0; k < all_tanks_.size(); ++k)
+        indexTank(k);
+
+    createParticipants();
+
+    shells_.clear();
+    shellCellVisits_.clear();
+    resetCellLayers();
+    scratchWarm_ = false;
+    resetStateHash();
+
+    currentStep_ = 0;
+    gameOver_    = false;
+    resultStr_.clear();
+}
 
+//------------------------------------------------------------------------------
+void GameState::createParticipants() {
     player1_ = player_factory_->create(1, rows_, cols_, maxSteps_, num_shells_);
     player2_ = player_factory_->create(2, rows_, cols_, maxSteps_, num_shells_);
+    concurrentPlayer_[1] = dynamic_cast<ConcurrentPlayer*>(player1_.get()) != nullptr;
+    concurrentPlayer_[2] = dynamic_cast<ConcurrentPlayer*>(player2_.get()) != nullptr;
 
     all_tank_algorithms_.clear();
+    deltaViewer_.clear();
     for (auto& ts : all_tanks_) {
         all_tank_algorithms_.push_back(
             tank_factory_->create(ts.player_index, ts.tank_index)
         );
+        deltaViewer_.push_back(
+            dynamic_cast<DeltaViewer*>(all_tank_algorithms_.back().get()) != nullptr);
     }
+    auto hashable = [](const auto& p) { return dynamic_cast<const StateHashable*>(p.get()) != nullptr; };
+    hashableParticipants_ = hashable(player1_) && hashable(player2_) &&
+        std::all_of(all_tank_algorithms_.begin(), all_tank_algorithms_.end(), hashable);
+    // the change log restarts with the board, so every first view is full
+    changeLog_.reset(*buildBattleSnapshot());
+    viewVersion_.assign(all_tanks_.size(), BattleChangeLog::NO_VIEW);
+}
 
-    shells_.clear();
-    toRemove_.clear();
-    positionMap_.clear();
+//------------------------------------------------------------------------------
+void GameState::resetCellLayers() {
+    shellCells_.reset(rows_ * cols_);
+    visitedOnce_.reset(rows_ * cols_);
+    visitedTwice_.reset(rows_ * cols_);
+    if (shellPlanes_) shellPlanes_->reset(board_);
+}
 
-    currentStep_ = 0;
-    gameOver_    = false;
-    resultStr_.clear();
+void GameState::setShellPlanes(bool on) {
+    if (!on) { shellPlanes_.reset(); return; }
+    if (shellPlanes_) return;
+    shellPlanes_ = std::make_unique<ShellPlanes>();
+    shellPlanes_->reset(board_);
 }
 
 //------------------------------------------------------------------------------
-std::string GameState::advanceOneTurn() {
-    if (gameOver_) return "";
+// Sizes the per-shell scratch for `peak` shells at once (growing at least
+// geometrically), so the turns that stay below it never reallocate.
+void GameState::reserveShellScratch(std::size_t peak) {
+    shellPeak_ = peak;
+    auto fit = [](auto& v, std::size_t n) {
+        if (v.capacity() < n) v.reserve(std::max(n, 2 * v.capacity()));
+    };
+    fit(shellOldPos_, peak);
+    fit(shellDelta_, peak);
+    fit(shellFirstStep_, peak);
+    fit(nextShellAtOldCell_, peak);
+    fit(shellCellVisits_, 2 * peak);   // one per shell and sub-step
+    shellsByOldCell_.reserve(peak);
+    shellAtCell_.reserve(peak);
+}
 
-    const size_t N = all_tanks_.size();
-    std::vector<ActionRequest> actions(N, ActionRequest::DoNothing);
-    std::vector<bool> ignored(N,false), killed(N,false);
+//------------------------------------------------------------------------------
+// State hashing and cycle detection. The picture term lives in changeLog_;
+// the others are rebuilt here when a game is (re)loaded and kept up by the
+// turn phases afterwards.
+//------------------------------------------------------------------------------
+namespace {
+std::uint64_t wallKey(std::size_t cell, int hits) {
+    return hits ? zobrist::key(zobrist::Part::WallHits, cell, std::uint64_t(hits)) : 0;
+}
+} // namespace
+
+void GameState::resetStateHash() {
+    const auto& cells = board_.getCells();
+    wallHash_ = 0;
+    for (std::size_t i = 0; i < cells.size(); ++i)
+        wallHash_ ^= wallKey(i, cells[i].wallHits());
+    shellHash_ = 0;
+    for (const Shell& sh : shells_) shellHash_ += shellKey(sh);
+    rehashTanks();
+    cycleAnchorSet_ = false;
+    cycleWindow_    = 1;
+}
 
-     // 1) Gather raw requests
-    for (size_t k = 0; k < N; ++k) {
-        auto& ts  = all_tanks_[k];
-        auto& alg = *all_tank_algorithms_[k];
-        if (!ts.alive) continue;
+void GameState::rehashTanks() {
+    tankHash_ = 0;
+    for (std::size_t k = 0; k < all_tanks_.size(); ++k) {
+        const auto& ts = all_tanks_[k];
+        std::uint64_t h = board_.index(ts.x, ts.y);
+        for (int v : {ts.direction, int(ts.alive), ts.shootCooldown,
+                      ts.backwardDelayCounter, int(ts.lastActionBackwardExecuted)})
+            h = zobrist::combine(h, std::uint64_t(v));
+        tankHash_ += zobrist::key(zobrist::Part::Tank, k, zobrist::combine(h, ts.shells_left));
+    }
+}
 
-        ActionRequest req = alg.getAction();
-        if (req == ActionRequest::GetBattleInfo) {
-            // build a visibility snapshot
-            std::vector<std::vector<char>> grid(rows_, std::vector<char>(cols_, ' '));
-            for (size_t yy = 0; yy < rows_; ++yy) {
-                for (size_t xx = 0; xx < cols_; ++xx) {
-                    const auto& cell = board_.getCell(int(xx), int(yy));
-                    grid[yy][xx] = (cell.content==CellContent::WALL ? '#' :
-                                    cell.content==CellContent::MINE ? '@' :
-                                    cell.content==CellContent::TANK1 ? '1' :
-                                    cell.content==CellContent::TANK2 ? '2' : ' ');
-                }
-            }
-            // mark the querying tank’s position specially
-            grid[ts.y][ts.x] = '%';
-
-            // construct the view and dispatch to the right player
-            MySatelliteView sv(grid, int(rows_), int(cols_), ts.x, ts.y);
-            if (ts.player_index == 1) {
-                player1_->updateTankWithBattleInfo(alg, sv);
-            } else {
-                player2_->updateTankWithBattleInfo(alg, sv);
-            }
+std::uint64_t GameState::stateHash() const {
+    std::uint64_t h = changeLog_.pictureHash() ^ wallHash_ ^ shellHash_ ^ tankHash_;
+    auto participant = [&](const auto* p, std::uint64_t id) {
+        if (auto* s = dynamic_cast<const StateHashable*>(p))
+            h ^= zobrist::key(zobrist::Part::Participant, id, s->stateHash());
+    };
+    participant(player1_.get(), 0);
+    participant(player2_.get(), 1);
+    for (std::size_t k = 0; k < all_tank_algorithms_.size(); ++k)
+        participant(all_tank_algorithms_[k].get(), 2 + k);
+    return h;
+}
+
+void GameState::checkForCycle() {
+    const std::uint64_t h = stateHash();
+    if (cycleAnchorSet_ && h == cycleAnchorHash_ && sameAsCycleAnchor()) {
+        int a1 = 0, a2 = 0;
+        for (auto const& ts : all_tanks_)
+            if (ts.alive) (ts.player_index == 1 ? ++a1 : ++a2);
+        gameOver_  = true;
+        resultStr_ = "Tie, game state repeats every " +
+                     std::to_string(currentStep_ - cycleAnchorStep_) + " steps" +
+                     ", player1 has " + std::to_string(a1) +
+                     ", player2 has " + std::to_string(a2);
+        return;
+    }
+    if (cycleAnchorSet_ && currentStep_ - cycleAnchorStep_ < cycleWindow_) return;
+    if (cycleAnchorSet_) cycleWindow_ *= 2;
+    cycleAnchorSet_  = true;
+    cycleAnchorStep_ = currentStep_;
+    cycleAnchorHash_ = h;
+    cycleAnchorCells_.assign(board_.getCells().begin(), board_.getCells().end());
+    cycleAnchorTanks_ = all_tanks_;
+    cycleAnchorShells_.assign(shells_.begin(), shells_.end());
+}
 
-            actions[k] = ActionRequest::GetBattleInfo;
+// Participants are only compared by hash; shell overlays follow from shells.
+bool GameState::sameAsCycleAnchor() const {
+    const auto& cells = board_.getCells();
+    auto sameCell = [](Cell a, Cell b) {
+        return ((a.bits ^ b.bits) & ~Cell::SHELL_BIT) == 0;
+    };
+    auto sameShell = [](const Shell& a, const Shell& b) {
+        return a.x == b.x && a.y == b.y && a.dir == b.dir;
+    };
+    return all_tanks_ == cycleAnchorTanks_ &&
+           std::equal(shells_.begin(), shells_.end(),
+                      cycleAnchorShells_.begin(), cycleAnchorShells_.end(), sameShell) &&
+           std::equal(cells.begin(), cells.end(),
+                      cycleAnchorCells_.begin(), cycleAnchorCells_.end(), sameCell);
+}
+
+//------------------------------------------------------------------------------
+void GameState::rebuildTankIndex() {
+    tankIdMap_.assign(3, {});
+    tankIdMap_[1].assign(std::size_t(nextTankIndex_[1]), SIZE_MAX);
+    tankIdMap_[2].assign(std::size_t(nextTankIndex_[2]), SIZE_MAX);
+    tankAtCell_.clear(all_tanks_.size());
+    for (std::size_t k = 0; k < all_tanks_.size(); ++k) {
+        const auto& ts = all_tanks_[k];
+        tankIdMap_[ts.player_index][ts.tank_index] = k;
+        if (ts.alive) indexTank(k);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Checkpoints. Field order here is the file format; bump CHECKPOINT_VERSION
+// when it changes. Per-turn indexes and the change log are not saved:
+// playOneTurn() and createParticipants() rebuild them from the board.
+//------------------------------------------------------------------------------
+namespace {
+void saveParticipant(CheckpointWriter& out, const Checkpointable* cp) {
+    out.putBool(cp != nullptr);
+    if (cp) cp->saveState(out);
+}
+
+template <typename Shells>
+void saveShells(CheckpointWriter& out, const Shells& shells) {
+    out.putU(shells.size());
+    for (const Shell& s : shells) {
+        out.putU(std::uint64_t(s.x));
+        out.putU(std::uint64_t(s.y));
+        out.putU(std::uint64_t(s.dir));
+    }
+}
+} // namespace
+
+void GameState::saveTanks(CheckpointWriter& out, const std::vector<TankState>& tanks) const {
+    out.putU(tanks.size());
+    for (const auto& ts : tanks) {
+        out.putU(std::uint64_t(ts.player_index));
+        out.putU(std::uint64_t(ts.tank_index));
+        out.putU(std::uint64_t(ts.x));
+        out.putU(std::uint64_t(ts.y));
+        out.putU(std::uint64_t(ts.direction));
+        out.putBool(ts.alive);
+        out.putU(ts.shells_left);
+        out.putI(ts.shootCooldown);
+        out.putI(ts.backwardDelayCounter);
+        out.putBool(ts.lastActionBackwardExecuted);
+    }
+}
+
+// Tanks must fit the board and the tank indices already read; `what`
+// names the first one that does not.
+bool GameState::loadTanks(CheckpointReader& in, std::vector<TankState>& tanks,
+                          std::string& what) const {
+    const std::uint64_t count = in.getU();
+    if (!in.ok() || count > rows_ * cols_) { what = "tank count"; return false; }
+    tanks.clear();
+    for (std::uint64_t k = 0; k < count; ++k) {
+        TankState ts{};
+        ts.player_index = int(in.getU());
+        ts.tank_index   = int(in.getU());
+        ts.x            = int(in.getU());
+        ts.y            = int(in.getU());
+        ts.direction    = int(in.getU());
+        ts.alive        = in.getBool();
+        ts.shells_left  = in.getU();
+        ts.shootCooldown              = int(in.getI());
+        ts.backwardDelayCounter       = int(in.getI());
+        ts.lastActionBackwardExecuted = in.getBool();
+        if (!in.ok() || (ts.player_index != 1 && ts.player_index != 2) ||
+            ts.tank_index < 0 || ts.tank_index >= nextTankIndex_[ts.player_index] ||
+            std::size_t(ts.x) >= cols_ || std::size_t(ts.y) >= rows_ ||
+            ts.direction < 0 || ts.direction > 7) {
+            what = "tank " + std::to_string(k);
+            return false;
         }
-        else {
-            actions[k] = req;
+        tanks.push_back(ts);
+    }
+    return true;
+}
+
+bool GameState::loadShells(CheckpointReader& in, std::vector<Shell>& shells,
+                           std::string& what) const {
+    const std::uint64_t count = in.getU();
+    shells.clear();
+    for (std::uint64_t i = 0; i < count && in.ok(); ++i) {
+        Shell s;
+        s.x   = int(in.getU());
+        s.y   = int(in.getU());
+        s.dir = int(in.getU());
+        if (std::size_t(s.x) >= cols_ || std::size_t(s.y) >= rows_ || s.dir < 0 || s.dir > 7) {
+            what = "shell " + std::to_string(i);
+            return false;
         }
+        shells.push_back(s);
     }
+    if (!in.ok()) { what = "shells"; return false; }
+    return true;
+}
+
+void GameState::saveCheckpoint(CheckpointWriter& out) const {
+    out.putU(rows_);
+    out.putU(cols_);
+    out.putU(maxSteps_);
+    out.putU(num_shells_);
+    out.putU(currentStep_);
+    out.putBool(gameOver_);
+    out.putString(resultStr_);
+    out.putU(std::uint64_t(nextTankIndex_[1]));
+    out.putU(std::uint64_t(nextTankIndex_[2]));
+
+    // one byte per cell: content, wall hits and shell overlay as packed
+    out.putBytes(board_.getCells().data(), board_.getCells().size());
+
+    saveTanks(out, all_tanks_);
+    saveShells(out, shells_);
+
+    saveParticipant(out, dynamic_cast<const Checkpointable*>(player1_.get()));
+    saveParticipant(out, dynamic_cast<const Checkpointable*>(player2_.get()));
+    for (const auto& algo : all_tank_algorithms_)
+        saveParticipant(out, dynamic_cast<const Checkpointable*>(algo.get()));
+
+    // cycle detection: a resumed game must match the same anchor on the
+    // same turn, and a match is confirmed against the anchor's full state
+    out.putBool(cycleAnchorSet_);
+    if (cycleAnchorSet_) {
+        out.putU(cycleAnchorStep_);
+        out.putU(cycleWindow_);
+        out.putU(cycleAnchorHash_);
+        out.putBytes(cycleAnchorCells_.data(), cycleAnchorCells_.size());
+        saveTanks(out, cycleAnchorTanks_);
+        saveShells(out, cycleAnchorShells_);
+    }
+}
+
+bool GameState::loadCheckpoint(CheckpointReader& in, std::string& error) {
+    gameOver_ = true;   // until the whole checkpoint has been read
+    auto fail = [&](const std::string& what) {
+        error = "bad checkpoint: " + what;
+        return false;
+    };
+
+    rows_        = in.getU();
+    cols_        = in.getU();
+    maxSteps_    = in.getU();
+    num_shells_  = in.getU();
+    currentStep_ = in.getU();
+    const bool over = in.getBool();
+    resultStr_   = in.getString();
+    nextTankIndex_[1] = int(in.getU());
+    nextTankIndex_[2] = int(in.getU());
+    if (!in.ok() || rows_ == 0 || cols_ == 0 || rows_ > UINT32_MAX / cols_)
+        return fail("header");
+
+    board_ = Board(rows_, cols_);
+    if (!in.getBytes(board_.row(0), rows_ * cols_))
+        return fail("board");
+
+    std::string what;
+    if (!loadTanks(in, all_tanks_, what)) return fail(what);
+    rebuildTankIndex();
+
+    shells_.clear();
+    shellCellVisits_.clear();
+    std::vector<Shell> shells;
+    if (!loadShells(in, shells, what)) return fail(what);
+    for (const Shell& s : shells) shells_.spawn(s);
+    resetCellLayers();
+    scratchWarm_ = false;
+
+    createParticipants();
+    auto restore = [&](Checkpointable* cp, const std::string& who) {
+        if (!in.getBool()) return in.ok();
+        if (!cp) return fail(who + " has saved state but cannot restore it");
+        return cp->loadState(in) || fail(who + " state");
+    };
+    if (!restore(dynamic_cast<Checkpointable*>(player1_.get()), "player 1") ||
+        !restore(dynamic_cast<Checkpointable*>(player2_.get()), "player 2"))
+        return false;
+    for (std::size_t k = 0; k < all_tank_algorithms_.size(); ++k) {
+        if (!restore(dynamic_cast<Checkpointable*>(all_tank_algorithms_[k].get()),
+                     "tank " + std::to_string(k)))
+            return false;
+    }
+    if (!in.ok()) return fail("truncated");
+
+    resetStateHash();
+    if (in.getBool()) {
+        cycleAnchorSet_  = true;
+        cycleAnchorStep_ = in.getU();
+        cycleWindow_     = in.getU();
+        cycleAnchorHash_ = in.getU();
+        cycleAnchorCells_.resize(rows_ * cols_);
+        if (!in.getBytes(cycleAnchorCells_.data(), cycleAnchorCells_.size()) ||
+            cycleAnchorStep_ > currentStep_ || cycleWindow_ == 0)
+            return fail("cycle anchor");
+        if (!loadTanks(in, cycleAnchorTanks_, what) || !loadShells(in, cycleAnchorShells_, what))
+            return fail("cycle anchor " + what);
+    }
+    if (!in.ok()) return fail("cycle anchor");
+
+    lastRequests_.clear();
+    lastIgnored_.clear();
+    lastOutcomes_.clear();
+    gameOver_ = over;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+std::string GameState::advanceOneTurn() {
+    if (gameOver_) return "";
+    playOneTurn();
+    std::string line;
+    appendTurnLine(line, lastOutcomes_);
+    return line;
+}
+
+//------------------------------------------------------------------------------
+void GameState::playOneTurn() {
+    if (gameOver_) return;
+
+    const size_t N = all_tanks_.size();
+    std::vector<ActionRequest>& actions = turnActions_;
+    std::vector<bool>& ignored = lastIgnored_;
+    std::vector<bool>& killed = turnKilled_;
+    actions.assign(N, ActionRequest::DoNothing);
+    killed.assign(N, false);
+    ignored.assign(N, false);
+    PhaseClock clock(phaseTimes_);
+
+     // 1) Gather raw requests
+    gatherActions(actions);
+    clock.lap(TurnPhase::Gather);
+    // players and algorithms allocate as they please; the engine phases
+    // from here on are checked against the counter
+    const std::uint64_t allocsBefore = allocationCount();
 // ─── Just after “Gather raw requests” and before any rotations ─────────────────
 // 1) Snapshot the original requests for logging
-std::vector<ActionRequest> logActions = actions;
+std::vector<ActionRequest>& logActions = lastRequests_;
+logActions = actions;
 
 // 2) Backward‐delay logic (2 turns idle, 3rd turn executes)
 for (size_t k = 0; k < N; ++k) {
@@ -180,34 +507,44 @@ for (size_t k = 0; k < N; ++k) {
     ts.lastActionBackwardExecuted = false;
     // actions[k] remains orig; ignored[k] stays false
 }
-
+    clock.lap(TurnPhase::BackwardDelay);
 
     // 2) Rotations
     applyTankRotations(actions);
-    
+    clock.lap(TurnPhase::Rotations);
 
     // 3) Mines
     handleTankMineCollisions();
+    clock.lap(TurnPhase::Mines);
 
     // 4) Cooldowns (unused)
     updateTankCooldowns();
 
     // 5) Backward legality check
     confirmBackwardMoves(ignored, actions);
+    clock.lap(TurnPhase::BackwardCheck);
 
     // 6) Shell movement & collisions
     updateShellsWithOverrunCheck();
+    clock.lap(TurnPhase::ShellMove);
     resolveShellCollisions();
+    clock.lap(TurnPhase::ShellCollisions);
 
     // 7) Shooting
     handleShooting(ignored, actions);
+    clock.lap(TurnPhase::Shooting);
+    // every shell of the turn, dying ones included, is in the pool now
+    const bool newShellPeak = shells_.size() > shellPeak_;
+    if (newShellPeak) reserveShellScratch(shells_.size());
 
     // 8) Tank movement, collisions
     updateTankPositionsOnBoard(ignored, killed, actions);
+    clock.lap(TurnPhase::TankMoves);
 
     // 9) Cleanup shells & entities
     filterRemainingShells();
     cleanupDestroyedEntities();
+    clock.lap(TurnPhase::Cleanup);
 
     // 10) End‐of‐game
     checkGameEndConditions();
@@ -216,55 +553,134 @@ for (size_t k = 0; k < N; ++k) {
     ++currentStep_;
     for (auto& ts : all_tanks_)
         if (ts.shootCooldown > 0) --ts.shootCooldown;
+    rehashTanks();
+    clock.lap(TurnPhase::EndCheck);
+    if (clock.active()) {
+        std::size_t alive = 0;
+        for (const auto& ts : all_tanks_) alive += ts.alive;
+        clock.endTurn(alive, shells_.size(), infoRequests_.size());
+    }
 
 
-    // ─── Console print of each tank's decision and status ────────────────────────
-    std::cout << "=== Decisions ===\n"<<std::endl;
-    for (size_t k = 0; k < N; ++k) {
-        const char* actName = actionToString(logActions[k]);
-        bool wasIgnored     = ignored[k]
-        && logActions[k] != common::ActionRequest::GetBattleInfo;
-        std::cout << "  Tank[" << k << "]: "
-        << actName
-        << (wasIgnored ? " (ignored)" : " (accepted)")
-        << "\n";
-    }
-    std::cout << std::endl;
-    std::cout << "=== Board State: ===\n" << std::endl;
-    
     // ─── Logging: use the ORIGINAL requests ────────────────────────────────────
-    std::ostringstream oss;
-    for (size_t k = 0; k < N; ++k) {
-        const auto act = logActions[k];
-        const char* name = "DoNothing";
-        switch (act) {
-          case ActionRequest::MoveForward:    name = "MoveForward";   break;
-          case ActionRequest::MoveBackward:   name = "MoveBackward";  break;
-          case ActionRequest::RotateLeft90:   name = "RotateLeft90";  break;
-          case ActionRequest::RotateRight90:  name = "RotateRight90"; break;
-          case ActionRequest::RotateLeft45:   name = "RotateLeft45";  break;
-          case ActionRequest::RotateRight45:  name = "RotateRight45"; break;
-          case ActionRequest::Shoot:          name = "Shoot";         break;
-          case ActionRequest::GetBattleInfo:  name = "GetBattleInfo"; break;
-          default:                                                    break;
-        }
+    lastOutcomes_.resize(N);
+    for (size_t k = 0; k < N; ++k)
+        lastOutcomes_[k] = makeOutcome(logActions[k], ignored[k], all_tanks_[k].alive);
+
+    // scratch grows on the first turn and with the shell count; the final
+    // turn formats the result string
+    const std::uint64_t allocs = allocationCount() - allocsBefore;
+    assert(allocs == 0 || !scratchWarm_ || newShellPeak || gameOver_);
+    (void)allocs;
+    (void)newShellPeak;
+    scratchWarm_ = true;
+
+    // after the allocation check: a new cycle anchor copies the board
+    if (cycleDetection_ && hashableParticipants_ && !gameOver_) checkForCycle();
+}
 
-        if (all_tanks_[k].alive) {
-            oss << name;
-            if (ignored[k] && act != ActionRequest::GetBattleInfo)
-            {
-                oss << " (ignored)";
-            }
-        } else {
-            // tank died this turn
-            if (act == ActionRequest::DoNothing)
-                oss << "killed";
-            else
-                oss << name << " (killed)";
+//------------------------------------------------------------------------------
+void GameState::setDecisionThreads(std::size_t threads) {
+    if (threads <= 1) decisionPool_.reset();
+    else              decisionPool_ = std::make_unique<ThreadPool>(threads);
+}
+
+//------------------------------------------------------------------------------
+// Step 1 of a turn. Each tank only sees its own getAction() followed, if it
+// asked, by its own battle info; tanks never observe each other here, so all
+// getAction() calls run first (in parallel when a pool is set) and the info
+// requests are answered afterwards in tank order.
+//------------------------------------------------------------------------------
+void GameState::gatherActions(std::vector<ActionRequest>& actions) {
+    const size_t N = all_tanks_.size();
+    auto decide = [&](size_t k) {
+        if (all_tanks_[k].alive)
+            actions[k] = all_tank_algorithms_[k]->getAction();
+    };
+    if (decisionPool_) decisionPool_->parallelFor(N, decide);
+    else               for (size_t k = 0; k < N; ++k) decide(k);
+
+    infoRequests_.clear();
+    for (size_t k = 0; k < N; ++k)
+        if (all_tanks_[k].alive && actions[k] == ActionRequest::GetBattleInfo)
+            infoRequests_.push_back(k);
+    if (infoRequests_.empty()) return;
+
+    // one shared snapshot per turn: the board cannot change while
+    // requests are gathered; the view adds each tank's '%' marker
+    const SnapshotPtr snapshot = changeLog_.snapshot();
+
+    auto dispatch = [&](size_t k) {
+        const auto& ts = all_tanks_[k];
+        thread_local std::vector<CellChange> changes;
+        changes.clear();
+        const bool wantsDelta = deltaViews_ && deltaViewer_[k];
+        const bool delta = wantsDelta && changeLog_.changesSince(viewVersion_[k], changes);
+        if (wantsDelta) viewVersion_[k] = changeLog_.version();
+        MySatelliteView sv(snapshot, ts.x, ts.y, delta ? &changes : nullptr);
+        common::Player& player = (ts.player_index == 1 ? *player1_ : *player2_);
+        player.updateTankWithBattleInfo(*all_tank_algorithms_[k], sv);
+    };
+    const bool anyConcurrent = concurrentPlayer_[1] || concurrentPlayer_[2];
+    if (decisionPool_ && anyConcurrent) {
+        // a ConcurrentPlayer's first request of the turn goes alone, so
+        // whatever it does once happens for the same tank as serially
+        constexpr size_t NONE = SIZE_MAX;
+        size_t lead[3] = {NONE, NONE, NONE};   // by player index
+        for (size_t i = 0; i < infoRequests_.size(); ++i) {
+            const int p = all_tanks_[infoRequests_[i]].player_index;
+            if (concurrentPlayer_[p] && lead[p] == NONE) lead[p] = i;
         }
-        if (k + 1 < N) oss << ", ";
+        for (int p : {1, 2})
+            if (lead[p] != NONE) dispatch(infoRequests_[lead[p]]);
+        decisionPool_->parallelFor(infoRequests_.size(), [&](size_t i) {
+            const size_t k = infoRequests_[i];
+            const int    p = all_tanks_[k].player_index;
+            if (concurrentPlayer_[p] && i != lead[p]) dispatch(k);
+        });
+    }
+    for (size_t k : infoRequests_) {
+        if (!(decisionPool_ && concurrentPlayer_[all_tanks_[k].player_index]))
+            dispatch(k);
     }
-    return oss.str();
+}
+
+//------------------------------------------------------------------------------
+const CellCharTable& GameState::viewChars() const {
+    return shellsInViews_ ? SATELLITE_SHELL_CHARS : SATELLITE_CHARS;
+}
+
+void GameState::setShellsInViews(bool on) {
+    if (on == shellsInViews_) return;
+    shellsInViews_ = on;
+    if (rows_ == 0) return;
+    // every cell under a shell changes character
+    changeLog_.reset(*buildBattleSnapshot());
+    viewVersion_.assign(all_tanks_.size(), BattleChangeLog::NO_VIEW);
+    cycleAnchorSet_ = false;
+    cycleWindow_    = 1;
+}
+
+SnapshotPtr GameState::buildBattleSnapshot() const {
+    auto snap = std::make_shared<BattleSnapshot>(rows_, cols_);
+    const auto& cells = board_.getCells();
+    cellsToChars(cells.data(), cells.size(), snap->cells.data(), viewChars());
+    snap->hash = zobrist::pictureHash(snap->cells.data(), snap->cells.size());
+    return snap;
+}
+
+// Every board write goes through one of these two, so changeLog_ always
+// matches buildBattleSnapshot().
+void GameState::setBoardCell(int x, int y, CellContent c) {
+    wallHash_ ^= wallKey(board_.index(x, y), board_.getCell(x, y).wallHits());   // setCell clears them
+    board_.setCell(x, y, c);
+    changeLog_.set(board_.index(x, y), cellChar(board_.getCell(x, y), viewChars()));
+    if (shellPlanes_) shellPlanes_->update(x, y, board_.getCell(x, y));
+}
+
+void GameState::noteCell(int x, int y) {
+    changeLog_.set(board_.index(x, y), cellChar(board_.getCell(x, y), viewChars()));
+    if (shellPlanes_) shellPlanes_->update(x, y, board_.getCell(x, y));
 }
 
 //------------------------------------------------------------------------------
@@ -272,41 +688,46 @@ bool GameState::isGameOver() const { return gameOver_; }
 std::string GameState::getResultString() const { return resultStr_; }
 
 //------------------------------------------------------------------------------
-void GameState::printBoard() const {
-    auto gridCopy = board_.getGrid();
-    for (auto const& sh : shells_)
-        gridCopy[sh.y][sh.x].hasShellOverlay = true;
+void GameState::printBoard(std::ostream& os) const {
+    // the whole board in one bulk conversion, then shells and live tanks
+    // on top; a shell only shows on an empty cell
+    const auto& cells = board_.getCells();
+    std::string& chars = boardChars_;
+    chars.resize(cells.size());
+    cellsToChars(cells.data(), cells.size(), chars.data(), RENDER_CHARS);
+    for (auto const& sh : shells_) {
+        const size_t i = board_.index(sh.x, sh.y);
+        if (cells[i].content() == CellContent::EMPTY) chars[i] = RENDER_CHARS.shell;
+    }
     for (auto const& ts : all_tanks_)
         if (ts.alive)
-            gridCopy[ts.y][ts.x].content = 
-                ts.player_index==1?CellContent::TANK1:CellContent::TANK2;
+            chars[board_.index(ts.x, ts.y)] = (ts.player_index==1 ? '1' : '2');
 
+    // rows go out in runs between tanks, which get a colored arrow instead
     for (size_t r=0; r<rows_; ++r) {
-        for (size_t c=0; c<cols_; ++c) {
-            const auto& cell = gridCopy[r][c];
-            switch(cell.content) {
-            case CellContent::WALL:  std::cout<<'#'; break;
-            case CellContent::MINE:  std::cout<<'@'; break;
-            case CellContent::EMPTY:
-                std::cout << (cell.hasShellOverlay? '*' : '_');
-                break;
-            case CellContent::TANK1:
-            case CellContent::TANK2: {
-                int pid = (cell.content==CellContent::TANK1?1:2);
-                int dir=0;
-                for (auto const& ts: all_tanks_) {
-                    if (ts.alive && ts.player_index==pid &&
-                        ts.x==int(c)&&ts.y==int(r)) { dir=ts.direction; break; }
-                }
-                const char* arr = directionToArrow(dir);
-                std::cout << (pid==1? "\033[31m": "\033[34m")
-                          << arr << "\033[0m";
-            } break;
-            }
+        const char* row = chars.data() + r*cols_;
+        const char* end = row + cols_;
+        const char* from = row;
+        for (;;) {
+            auto* t1 = static_cast<const char*>(std::memchr(from, '1', size_t(end - from)));
+            auto* t2 = static_cast<const char*>(std::memchr(from, '2', size_t(end - from)));
+            const char* tank = !t1 ? t2 : !t2 ? t1 : std::min(t1, t2);
+            if (!tank) break;
+            os.write(from, tank - from);
+            from = tank + 1;
+            int pid = (*tank=='1'?1:2);
+            int dir=0;
+            std::uint32_t k = tankAt(int(tank - row), int(r));
+            if (k != CellSlotMap::NONE && all_tanks_[k].player_index==pid)
+                dir = all_tanks_[k].direction;
+            const char* arr = directionToArrow(dir);
+            os << (pid==1? "\033[31m": "\033[34m")
+                      << arr << "\033[0m";
         }
-        std::cout<<"\n";
+        os.write(from, end - from);
+        os<<"\n";
     }
-    std::cout<<std::endl;
+    os<<"\n";
 }
 
 //------------------------------------------------------------------------------
@@ -331,12 +752,15 @@ void GameState::applyTankRotations(const std::vector<ActionRequest>& A) {
 }
 
 void GameState::handleTankMineCollisions() {
-    for (auto& ts: all_tanks_) {
+    for (size_t k = 0; k < all_tanks_.size(); ++k) {
+        auto& ts = all_tanks_[k];
         if (!ts.alive) continue;
         auto& cell = board_.getCell(ts.x, ts.y);
-        if (cell.content==CellContent::MINE) {
+        if (cell.content()==CellContent::MINE) {
+            unindexTank(k);
             ts.alive = false;
-            cell.content = CellContent::EMPTY;
+            cell.setContent(CellContent::EMPTY);
+            noteCell(ts.x, ts.y);
         }
     }
 }
@@ -373,7 +797,7 @@ void GameState::confirmBackwardMoves(std::vector<bool>& ignored,
         // wrap around
         board_.wrapCoords(nx, ny);
         // illegal if there's a wall after wrapping
-        if (board_.getCell(nx, ny).content == CellContent::WALL) {
+        if (board_.getCell(nx, ny).content() == CellContent::WALL) {
             ignored[k] = true;
         }
     }
@@ -389,8 +813,29 @@ void GameState::updateTankPositionsOnBoard(std::vector<bool>& ignored,
 {
      board_.clearTankMarks();
 
+    // mark every shell (dying ones included); a tank stepping onto a marked
+    // cell looks up the lowest-index shell there
+    for (const Shell& sh : shells_)
+        shellCells_.set(board_.index(sh.x, sh.y));
+    bool shellIndexBuilt = false;
+    auto shellAt = [&](int x, int y) {
+        const std::size_t cell = board_.index(x, y);
+        if (!shellCells_.test(cell)) return CellSlotMap::NONE;
+        if (!shellIndexBuilt) {
+            shellAtCell_.clear(shells_.size());
+            for (std::size_t s = 0; s < shells_.size(); ++s)
+                shellAtCell_.slot(std::uint32_t(board_.index(shells_[s].x, shells_[s].y)),
+                                  std::uint32_t(s));
+            shellIndexBuilt = true;
+        }
+        return shellAtCell_.find(std::uint32_t(cell));
+    };
+
     const size_t N = all_tanks_.size();
-    std::vector<std::pair<int,int>> oldPos(N), newPos(N);
+    std::vector<std::pair<int,int>>& oldPos = tankOldPos_;
+    std::vector<std::pair<int,int>>& newPos = tankNewPos_;
+    oldPos.resize(N);
+    newPos.resize(N);
 
     // 1) compute oldPos & newPos (with wrapping)
     for (size_t k = 0; k < N; ++k) {
@@ -428,7 +873,7 @@ void GameState::updateTankPositionsOnBoard(std::vector<bool>& ignored,
         board_.wrapCoords(nx, ny);
 
         // if after wrapping there's a wall, treat as ignored
-        if (board_.getCell(nx, ny).content == CellContent::WALL) {
+        if (board_.getCell(nx, ny).content() == CellContent::WALL) {
             newPos[k] = oldPos[k];
             ignored[k] = true;
         } else {
@@ -436,60 +881,52 @@ void GameState::updateTankPositionsOnBoard(std::vector<bool>& ignored,
         }
     }
 
+    // Every live tank is still indexed at oldPos here, so the occupant of a
+    // destination cell is a single lookup.
+    auto kill = [&](std::size_t k) {
+        unindexTank(k);
+        killedThisTurn[k]   = true;
+        all_tanks_[k].alive = false;
+        setBoardCell(oldPos[k].first, oldPos[k].second, CellContent::EMPTY);
+    };
+
     // 2a) Head-on swaps: two tanks exchanging places → both die
     for (std::size_t i = 0; i < N; ++i) {
-      for (std::size_t j = i+1; j < N; ++j) {
-        if (!all_tanks_[i].alive || !all_tanks_[j].alive) continue;
-        if (killedThisTurn[i] || killedThisTurn[j])        continue;
-        if (newPos[i] == oldPos[j] && newPos[j] == oldPos[i]) {
-          killedThisTurn[i] = killedThisTurn[j] = true;
-          all_tanks_[i].alive = all_tanks_[j].alive = false;
-          // clear both old positions
-          board_.setCell(oldPos[i].first, oldPos[i].second, CellContent::EMPTY);
-          board_.setCell(oldPos[j].first, oldPos[j].second, CellContent::EMPTY);
+        if (!all_tanks_[i].alive || killedThisTurn[i]) continue;
+        if (newPos[i] == oldPos[i]) continue;
+        std::uint32_t j = tankAt(newPos[i].first, newPos[i].second);
+        if (j == CellSlotMap::NONE || j == i || killedThisTurn[j]) continue;
+        if (newPos[j] == oldPos[i]) {
+            kill(i);
+            kill(j);
         }
-      }
     }
 
     // 2b) Moving-into-stationary: a mover steps onto someone who stayed put → both die
     for (std::size_t k = 0; k < N; ++k) {
-      if (!all_tanks_[k].alive                   ) continue;  // dead already
-      if (killedThisTurn[k]                      ) continue;  // marked in 2a
-      if (newPos[k] == oldPos[k]) continue;                 // didn’t move
-      for (std::size_t j = 0; j < N; ++j) {
-        if (j == k)                                             continue;
-        if (!all_tanks_[j].alive                              ) continue;  // dead
-        if (killedThisTurn[j]                                 ) continue;  // marked
-        if (newPos[j] != oldPos[j]) continue;                   // j must be stationary
-        if (newPos[k] == oldPos[j]) {
-          // k moved into j’s square
-          killedThisTurn[k] = killedThisTurn[j] = true;
-          all_tanks_[k].alive = all_tanks_[j].alive = false;
-          board_.setCell(oldPos[k].first, oldPos[k].second, CellContent::EMPTY);
-          board_.setCell(oldPos[j].first, oldPos[j].second, CellContent::EMPTY);
-        }
-      }
+        if (!all_tanks_[k].alive) continue;      // dead already
+        if (killedThisTurn[k]) continue;         // marked in 2a
+        if (newPos[k] == oldPos[k]) continue;    // didn’t move
+        std::uint32_t j = tankAt(newPos[k].first, newPos[k].second);
+        if (j == CellSlotMap::NONE || j == k || killedThisTurn[j]) continue;
+        if (newPos[j] != oldPos[j]) continue;    // j must be stationary
+        // k moved into j’s square
+        kill(k);
+        kill(j);
     }
 
     // 2c) Multi-tank collisions at same destination: any cell with ≥2 movers → all die
-    std::map<std::pair<int,int>, std::vector<std::size_t>> destMap;
-    for (std::size_t k = 0; k < N; ++k) {
-      if (!all_tanks_[k].alive 
-       || killedThisTurn[k] 
-       || newPos[k] == oldPos[k]) continue;
-      destMap[newPos[k]].push_back(k);
-    }
-    for (auto const& [pos, vec] : destMap) {
-      if (vec.size() > 1) {
-        for (auto k : vec) {
-          if (!all_tanks_[k].alive || killedThisTurn[k]) continue;
-          killedThisTurn[k]   = true;
-          all_tanks_[k].alive = false;
-          // clear their old position
-          board_.setCell(oldPos[k].first, oldPos[k].second, CellContent::EMPTY);
-        }
-      }
-    }
+    tankDestCount_.clear(N);
+    auto destCell = [&](std::size_t k) {
+        return std::uint32_t(board_.index(newPos[k].first, newPos[k].second));
+    };
+    auto isMover = [&](std::size_t k) {
+        return all_tanks_[k].alive && !killedThisTurn[k] && newPos[k] != oldPos[k];
+    };
+    for (std::size_t k = 0; k < N; ++k)
+        if (isMover(k)) ++tankDestCount_.slot(destCell(k), 0);
+    for (std::size_t k = 0; k < N; ++k)
+        if (isMover(k) && tankDestCount_.find(destCell(k)) > 1) kill(k);
 
 
     // 3) Now apply every non‐colliding move
@@ -502,7 +939,7 @@ void GameState::updateTankPositionsOnBoard(std::vector<bool>& ignored,
 
         // stayed in place?
         if (nx == ox && ny == oy) {
-            board_.setCell(ox, oy,
+            setBoardCell(ox, oy,
                 all_tanks_[k].player_index == 1
                   ? CellContent::TANK1
                   : CellContent::TANK2
@@ -511,9 +948,9 @@ void GameState::updateTankPositionsOnBoard(std::vector<bool>& ignored,
         }
 
         // illegal: wall
-        if (board_.getCell(nx, ny).content == CellContent::WALL) {
+        if (board_.getCell(nx, ny).content() == CellContent::WALL) {
             ignored[k] = true;
-            board_.setCell(ox, oy,
+            setBoardCell(ox, oy,
                 all_tanks_[k].player_index == 1
                   ? CellContent::TANK1
                   : CellContent::TANK2
@@ -522,45 +959,52 @@ void GameState::updateTankPositionsOnBoard(std::vector<bool>& ignored,
         }
 
         // --- NEW: mutual shell‐tank destruction ---
+        //     Shells that died earlier this turn (on a wall, a tank or
+        //     another shell) stay in shells_, flagged, until
+        //     filterRemainingShells(), and sit where they stopped. A tank
+        //     moving onto one dies with it all the same, as it did when
+        //     the engine kept dying shells in a list until the turn's end.
         {
-            bool collidedWithShell = false;
-            for (size_t s = 0; s < shells_.size(); ++s) {
-                if (shells_[s].x == nx && shells_[s].y == ny) {
-                    // kill tank
-                    all_tanks_[k].alive = false;
-                    killedThisTurn[k]   = true;
-                    // clear its old cell
-                    board_.setCell(ox, oy, CellContent::EMPTY);
-                    board_.setCell(nx, ny, CellContent::EMPTY);
-                    // remove that shell
-                    shells_.erase(shells_.begin() + s);
-                    collidedWithShell = true;
-                    break;
-                }
-            }
-            if (collidedWithShell)
+            std::uint32_t s = shellAt(nx, ny);
+            if (s != CellSlotMap::NONE) {
+                // kill tank
+                unindexTank(k);
+                all_tanks_[k].alive = false;
+                killedThisTurn[k]   = true;
+                // clear its old cell
+                setBoardCell(ox, oy, CellContent::EMPTY);
+                setBoardCell(nx, ny, CellContent::EMPTY);
+                // remove that shell
+                shells_.kill(s);
                 continue;  // tank is dead, skip the rest
+            }
         }
 
         // mine → both die
-        if (board_.getCell(nx, ny).content == CellContent::MINE) {
+        if (board_.getCell(nx, ny).content() == CellContent::MINE) {
+            unindexTank(k);
             killedThisTurn[k]   = true;
             all_tanks_[k].alive = false;
-            board_.setCell(ox, oy, CellContent::EMPTY);
-            board_.setCell(nx, ny, CellContent::EMPTY);
+            setBoardCell(ox, oy, CellContent::EMPTY);
+            setBoardCell(nx, ny, CellContent::EMPTY);
             continue;
         }
 
         // normal move
-        board_.setCell(ox, oy, CellContent::EMPTY);
+        setBoardCell(ox, oy, CellContent::EMPTY);
+        unindexTank(k);
         all_tanks_[k].x = nx;
         all_tanks_[k].y = ny;
-        board_.setCell(nx, ny,
+        indexTank(k);
+        setBoardCell(nx, ny,
             all_tanks_[k].player_index == 1
               ? CellContent::TANK1
               : CellContent::TANK2
         );
     }
+
+    for (const Shell& sh : shells_)
+        shellCells_.clear(board_.index(sh.x, sh.y));
 }
 
 void GameState::handleShooting(std::vector<bool>& ignored,
@@ -577,7 +1021,7 @@ void GameState::handleShooting(std::vector<bool>& ignored,
         int sx=(ts.x+dx+board_.getWidth())%board_.getWidth();
         int sy=(ts.y+dy+board_.getHeight())%board_.getHeight();
         if (!handleShellMidStepCollision(sx,sy))
-            shells_.push_back({sx,sy,ts.direction});
+            shells_.spawn({sx,sy,ts.direction});
     };
 
     for (size_t k = 0; k < all_tanks_.size(); ++k) {
@@ -609,14 +1053,28 @@ void GameState::handleShooting(std::vector<bool>& ignored,
 //     move each shell in two unit-steps, checking for wall/tank collisions
 //     and also if two shells cross through each other.
 void GameState::updateShellsWithOverrunCheck() {
-    toRemove_.clear();
-    positionMap_.clear();
-    board_.clearShellMarks();
+    shellCellVisits_.clear();
+    // overlays are only set on last turn's survivors, which are all in shells_
+    for (const Shell& sh : shells_) {
+        board_.getCell(sh.x, sh.y).setShellOverlay(false);
+        if (shellsInViews_) noteCell(sh.x, sh.y);
+    }
+
+    if (shellPlanes_ && !shells_.empty() && shellPlanes_->plan(shells_)) {
+        moveShellsByPlan();
+        return;
+    }
 
     const size_t S = shells_.size();
-    // 1) snapshot old positions and deltas
-    std::vector<std::pair<int,int>> oldPos(S);
-    std::vector<std::pair<int,int>> delta(S);
+    auto cellOf = [&](int x, int y) { return std::uint32_t(board_.index(x, y)); };
+
+    // 1) snapshot old positions, deltas and first-step targets
+    std::vector<std::pair<int,int>>& oldPos    = shellOldPos_;
+    std::vector<std::pair<int,int>>& delta     = shellDelta_;
+    std::vector<std::pair<int,int>>& firstStep = shellFirstStep_;
+    oldPos.resize(S);
+    delta.resize(S);
+    firstStep.resize(S);
     for (size_t i = 0; i < S; ++i) {
         oldPos[i] = { shells_[i].x, shells_[i].y };
         int dx = 0, dy = 0;
@@ -631,37 +1089,55 @@ void GameState::updateShellsWithOverrunCheck() {
           case 7:  dx = -1; dy = -1; break;
         }
         delta[i] = {dx, dy};
+        int fx = oldPos[i].first + dx, fy = oldPos[i].second + dy;
+        board_.wrapCoords(fx, fy);
+        firstStep[i] = {fx, fy};
+        shellCells_.set(cellOf(oldPos[i].first, oldPos[i].second));
+    }
+
+    //    bucket by old cell, chained in increasing index order, the shells
+    //    whose first step lands where another shell started: only those
+    //    can be the partner in a crossing
+    auto crossable = [&](size_t j) {
+        return shellCells_.test(cellOf(firstStep[j].first, firstStep[j].second));
+    };
+    size_t buckets = 0;
+    for (size_t j = 0; j < S; ++j) buckets += crossable(j);
+    shellsByOldCell_.clear(buckets);
+    nextShellAtOldCell_.assign(S, CellSlotMap::NONE);
+    for (size_t j = S; j-- > 0; ) {
+        if (!crossable(j)) continue;
+        std::uint32_t& head = shellsByOldCell_.slot(cellOf(oldPos[j].first, oldPos[j].second));
+        nextShellAtOldCell_[j] = head;
+        head = std::uint32_t(j);
     }
 
     // 2) perform two sub-steps simultaneously
     for (int step = 0; step < 2; ++step) {
         for (size_t i = 0; i < shells_.size(); ++i) {
-            if (toRemove_.count(i)) continue;  // already dying
+            if (shells_.isDead(i)) continue;  // already dying
 
             // compute this shell's next position
             int nx = shells_[i].x + delta[i].first;
             int ny = shells_[i].y + delta[i].second;
             board_.wrapCoords(nx, ny);
 
-            // 2a) crossing-paths check
-            for (size_t j = 0; j < shells_.size(); ++j) {
-                if (i == j || toRemove_.count(j)) continue;
-                // j's old and would-be new pos
-                auto [oxj, oyj] = oldPos[j];
-                int nxj = oxj + delta[j].first;
-                int nyj = oyj + delta[j].second;
-                board_.wrapCoords(nxj, nyj);
-                // if i’s new == j’s old AND j’s new == i’s old → cross
-                if (nx == oxj && ny == oyj
-                 && nxj == oldPos[i].first
-                 && nyj == oldPos[i].second)
-                {
-                    toRemove_.insert(i);
-                    toRemove_.insert(j);
+            // 2a) crossing-paths check: only shells that started the turn on
+            //     i's next cell can cross it; take the lowest such index whose
+            //     first step lands on i's old cell
+            for (std::uint32_t j = shellCells_.test(cellOf(nx, ny))
+                                       ? shellsByOldCell_.find(cellOf(nx, ny))
+                                       : CellSlotMap::NONE;
+                 j != CellSlotMap::NONE; j = nextShellAtOldCell_[j])
+            {
+                if (j == i || shells_.isDead(j)) continue;
+                if (firstStep[j] == oldPos[i]) {
+                    shells_.kill(i);
+                    shells_.kill(j);
                     break;
                 }
             }
-            if (toRemove_.count(i)) continue;
+            if (shells_.isDead(i)) continue;
 
             // advance the shell
             shells_[i].x = nx;
@@ -669,42 +1145,82 @@ void GameState::updateShellsWithOverrunCheck() {
 
             // 2b) tank/wall mid-step collision
             if (handleShellMidStepCollision(nx, ny)) {
-                toRemove_.insert(i);
+                shells_.kill(i);
                 continue;
             }
 
             // 2c) record for same-cell collisions
-            positionMap_[{nx, ny}].push_back(i);
+            shellCellVisits_.push_back({cellOf(nx, ny), i});
         }
     }
+
+    for (const auto& [x, y] : oldPos)
+        shellCells_.clear(cellOf(x, y));
 }
 
+namespace {
+constexpr int DIR_DX[8] = {0,1,1,1,0,-1,-1,-1};
+constexpr int DIR_DY[8] = {-1,-1,0,1,1,1,0,-1};
+} // namespace
+
+// The same two sub-steps with ShellPlanes' answers for crossings and
+// shared cells: one pass per sub-step applies the wall and tank hits in
+// shell order, then a pass drops the shells that shared a cell.
+// resolveShellCollisions() finds no visits to add.
+void GameState::moveShellsByPlan() {
+    const ShellPlanes& plan = *shellPlanes_;
+    auto advance = [&](Shell& sh) {
+        sh.x += DIR_DX[sh.dir];
+        sh.y += DIR_DY[sh.dir];
+        board_.wrapCoords(sh.x, sh.y);
+    };
+    for (size_t i = 0; i < shells_.size(); ++i) {
+        Shell& sh = shells_[i];
+        if (plan.crossed(sh)) { shells_.kill(i); continue; }
+        advance(sh);
+        if (handleShellMidStepCollision(sh.x, sh.y)) shells_.kill(i);
+    }
+    for (size_t i = 0; i < shells_.size(); ++i) {
+        if (shells_.isDead(i)) continue;
+        Shell& sh = shells_[i];
+        advance(sh);
+        const bool hit = handleShellMidStepCollision(sh.x, sh.y);
+        if (hit) shells_.kill(i);
+        assert(plan.arrived(sh) != hit);
+    }
+    for (size_t i = 0; i < shells_.size(); ++i) {
+        if (shells_.isDead(i)) continue;
+        const Shell& sh = shells_[i];
+        int fx = sh.x - DIR_DX[sh.dir], fy = sh.y - DIR_DY[sh.dir];
+        board_.wrapCoords(fx, fy);
+        if (plan.shared(fx, fy) || plan.shared(sh.x, sh.y)) shells_.kill(i);
+    }
+}
 
 void GameState::resolveShellCollisions() {
     // if two or more shells occupy the same cell, they all die
-    for (auto const& entry : positionMap_) {
-        const auto& idxs = entry.second;
-        if (idxs.size() > 1) {
-            for (auto idx : idxs) {
-                toRemove_.insert(idx);
-            }
+    for (auto const& [cell, idx] : shellCellVisits_)
+        if (visitedOnce_.testAndSet(cell)) visitedTwice_.set(cell);
+    for (auto const& [cell, idx] : shellCellVisits_) {
+        if (visitedTwice_.test(cell)) {
+            shells_.kill(idx);
         }
     }
+    for (auto const& [cell, idx] : shellCellVisits_) {
+        visitedOnce_.clear(cell);
+        visitedTwice_.clear(cell);
+    }
 }
 
 void GameState::filterRemainingShells() {
-    std::vector<Shell> remaining;
-    remaining.reserve(shells_.size());
-    for (std::size_t i = 0; i < shells_.size(); ++i) {
-        // survivors are those not in toRemove_
-        if (toRemove_.count(i) == 0) {
-            // mark overlay
-            auto& cell = board_.getCell(shells_[i].x, shells_[i].y);
-            cell.hasShellOverlay = true;
-            remaining.push_back(shells_[i]);
-        }
+    shells_.compact();
+    // mark overlay for the survivors
+    shellHash_ = 0;
+    for (auto const& sh : shells_) {
+        board_.getCell(sh.x, sh.y).setShellOverlay(true);
+        if (shellsInViews_) noteCell(sh.x, sh.y);
+        shellHash_ += shellKey(sh);
     }
-    shells_.swap(remaining);
 }
 
 //------------------------------------------------------------------------------
@@ -714,25 +1230,31 @@ bool GameState::handleShellMidStepCollision(int x, int y) {
     Cell& cell = board_.getCell(x, y);
 
     // 1) Wall?
-    if (cell.content == CellContent::WALL) {
-        cell.wallHits++;
-        if (cell.wallHits >= 2) {
-            cell.content = CellContent::EMPTY;
+    if (cell.content() == CellContent::WALL) {
+        const std::size_t i = board_.index(x, y);
+        wallHash_ ^= wallKey(i, cell.wallHits());
+        const int hits = cell.addWallHit();
+        wallHash_ ^= wallKey(i, hits);
+        if (hits >= 2) {
+            cell.setContent(CellContent::EMPTY);
+            noteCell(x, y);
+        } else if (shellPlanes_) {
+            shellPlanes_->update(x, y, cell);   // damaged, not in the picture
         }
         return true;
     }
 
     // 2) Tank?
-    if (cell.content == CellContent::TANK1 || cell.content == CellContent::TANK2) {
+    if (cell.content() == CellContent::TANK1 || cell.content() == CellContent::TANK2) {
         // find and kill the matching TankState
-        int pid = (cell.content == CellContent::TANK1 ? 1 : 2);
-        for (auto& ts : all_tanks_) {
-            if (ts.alive && ts.player_index == pid && ts.x == x && ts.y == y) {
-                ts.alive = false;
-                break;
-            }
+        int pid = (cell.content() == CellContent::TANK1 ? 1 : 2);
+        std::uint32_t k = tankAt(x, y);
+        if (k != CellSlotMap::NONE && all_tanks_[k].player_index == pid) {
+            unindexTank(k);
+            all_tanks_[k].alive = false;
         }
-        cell.content = CellContent::EMPTY;
+        cell.setContent(CellContent::EMPTY);
+        noteCell(x, y);
         return true;
     }
 
@@ -740,6 +1262,27 @@ bool GameState::handleShellMidStepCollision(int x, int y) {
     return false;
 }
 
+//------------------------------------------------------------------------------
+// Cell → tank index helpers. A cell maps to at most one live tank; while
+// moves are being applied a tank may briefly overwrite the entry of one that
+// is about to leave, so removal only clears entries that still point at k.
+//------------------------------------------------------------------------------
+std::uint32_t GameState::tankAt(int x, int y) const {
+    return tankAtCell_.find(std::uint32_t(board_.index(x, y)));
+}
+
+void GameState::indexTank(std::size_t k) {
+    const auto& ts = all_tanks_[k];
+    tankAtCell_.slot(std::uint32_t(board_.index(ts.x, ts.y))) = std::uint32_t(k);
+}
+
+void GameState::unindexTank(std::size_t k) {
+    const auto& ts = all_tanks_[k];
+    const std::uint32_t cell = std::uint32_t(board_.index(ts.x, ts.y));
+    if (tankAtCell_.find(cell) == k)
+        tankAtCell_.erase(cell);
+}
+
 void GameState::cleanupDestroyedEntities() {
     // nothing
 }
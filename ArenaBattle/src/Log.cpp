@@ -0,0 +1,108 @@
+// src/Log.cpp
+#include "Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <mutex>
+
+using namespace arena;
+
+namespace {
+
+constexpr LogLevel COMPILED_LEVEL = LogLevel(ARENA_LOG_LEVEL);
+
+const char* const NAMES[] = { "off", "error", "warn", "info", "debug", "trace" };
+
+/// Pending text and the sink it is headed for. Flushed when full, on error
+/// lines, on flushLog(), and at exit.
+struct LogState {
+    std::atomic<int> level{ int(COMPILED_LEVEL) };
+    std::mutex       mutex;
+    std::string      pending;
+    std::size_t      capacity = 64 * 1024;
+    std::ostream*    sink     = nullptr;
+
+    void flushLocked() {
+        if (pending.empty()) return;
+        std::ostream& os = sink ? *sink : std::cerr;
+        os.write(pending.data(), std::streamsize(pending.size()));
+        os.flush();
+        pending.clear();
+    }
+
+    ~LogState() {
+        std::lock_guard<std::mutex> lock(mutex);
+        flushLocked();
+    }
+};
+
+LogState& state() {
+    static LogState s;
+    return s;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+const char* arena::logLevelName(LogLevel level) {
+    const int i = int(level);
+    return i >= 0 && i <= int(LogLevel::Trace) ? NAMES[i] : "?";
+}
+
+bool arena::parseLogLevel(const std::string& name, LogLevel& out) {
+    for (int i = 0; i <= int(LogLevel::Trace); ++i) {
+        if (name == NAMES[i]) {
+            out = LogLevel(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void arena::setLogLevel(LogLevel level) {
+    state().level.store(int(std::min(level, COMPILED_LEVEL)), std::memory_order_relaxed);
+}
+
+LogLevel arena::logLevel() {
+    return LogLevel(state().level.load(std::memory_order_relaxed));
+}
+
+bool arena::logEnabled(LogLevel level) {
+    return int(level) <= state().level.load(std::memory_order_relaxed);
+}
+
+void arena::setLogSink(std::ostream* sink) {
+    LogState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.flushLocked();
+    s.sink = sink;
+}
+
+void arena::setLogBuffer(std::size_t bytes) {
+    LogState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.capacity = bytes;
+    if (s.pending.size() >= s.capacity) s.flushLocked();
+}
+
+void arena::flushLog() {
+    LogState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.flushLocked();
+}
+
+//------------------------------------------------------------------------------
+LogLine::~LogLine() {
+    // format outside the lock; only the append is serialized
+    std::string line = logLevelName(level_);
+    for (char& c : line) c = char(c - 'a' + 'A');
+    line += ": ";
+    line += out_.str();
+    line += '\n';
+
+    LogState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.pending += line;
+    if (s.pending.size() >= s.capacity || level_ == LogLevel::Error) s.flushLocked();
+}
@@ -0,0 +1,92 @@
+// src/MapLoader.cpp
+#include "MapLoader.h"
+#include "utils.h"
+
+#include <cstdint>
+#include <fstream>
+#include <istream>
+
+using namespace arena;
+
+namespace {
+
+/// Cell for a grid character, or false if `ch` cannot appear in a grid row.
+inline bool gridCell(char ch, CellContent& out) {
+    switch (ch) {
+        case '.': out = CellContent::EMPTY; return true;
+        case '#': out = CellContent::WALL;  return true;
+        case '@': out = CellContent::MINE;  return true;
+        case '1': out = CellContent::TANK1; return true;
+        case '2': out = CellContent::TANK2; return true;
+        default:  return false;
+    }
+}
+
+bool isGridRow(const std::string& line) {
+    if (line.empty()) return false;
+    CellContent unused;
+    for (char ch : line)
+        if (!gridCell(ch, unused)) return false;
+    return true;
+}
+
+bool readHeader(std::istream& in, std::string& line, const char* key,
+                std::size_t& out, std::string& error)
+{
+    if (!std::getline(in, line) || !parseKeyValue(line, key, out)) {
+        error = std::string("Invalid header (") + key + "): \"" + line + "\"";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+bool arena::loadMap(std::istream& in, MapData& map, std::string& error) {
+    std::string line;
+    std::size_t rows = 0, cols = 0;
+
+    if (!std::getline(in, map.title)) {
+        error = "Invalid map file: missing title line";
+        return false;
+    }
+    if (!readHeader(in, line, "MaxSteps",  map.maxSteps,  error) ||
+        !readHeader(in, line, "NumShells", map.numShells, error) ||
+        !readHeader(in, line, "Rows",      rows,          error) ||
+        !readHeader(in, line, "Cols",      cols,          error))
+        return false;
+    if (cols != 0 && rows > SIZE_MAX / cols) {
+        error = "Invalid map file: board of " + std::to_string(rows) + "x" +
+                std::to_string(cols) + " cells is too large";
+        return false;
+    }
+
+    map.board = Board(rows, cols);
+    for (std::size_t r = 0; r < rows && std::getline(in, line);) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!isGridRow(line)) continue;
+
+        Cell* row = map.board.row(r++);
+        const std::size_t n = line.size() < cols ? line.size() : cols;
+        CellContent content = CellContent::EMPTY;
+        for (std::size_t c = 0; c < n; ++c) {
+            gridCell(line[c], content);
+            row[c].bits = std::uint8_t(content);
+        }
+    }
+    if (in.bad()) {
+        error = "Invalid map file: read error";
+        return false;
+    }
+    return true;
+}
+
+bool arena::loadMap(const std::string& path, MapData& map, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "Cannot open map file: " + path;
+        return false;
+    }
+    return loadMap(in, map, error);
+}
@@ -1,22 +1,100 @@
 #include "MyBattleInfo.h"
+#include "MySatelliteView.h"
 
-// namespace arena {
-// //TODO: fix logic
-// // MyBattleInfo::MyBattleInfo(std::size_t r, std::size_t c)
-// //   : rows(r), cols(c), grid(r, std::vector<char>(c, ' '))
-// // {}
-
-// void MyBattleInfo::setObjectAt(size_t x, size_t y, char c) {
-//     if (x < rows && y < cols) {
-//         grid[x][y] = c;
-//     }
-// }
-
-// char MyBattleInfo::getObjectAt(size_t x, size_t y) const {
-//     if (x < rows && y < cols) {
-//         return grid[x][y];
-//     }
-//     return '&'; // outside battlefield
-// }
-
-// } // namespace arena
+using namespace arena;
+
+MyBattleInfo MyBattleInfo::fromView(const common::SatelliteView& sv,
+                                    std::size_t rows, std::size_t cols)
+{
+    MyBattleInfo info(rows, cols);
+
+    if (auto* mine = dynamic_cast<const MySatelliteView*>(&sv)) {
+        if (mine->changes()) {
+            info.delta   = true;
+            info.changes = *mine->changes();
+        } else {
+            info.snapshot = mine->snapshot();
+        }
+        info.selfX     = mine->queryX();
+        info.selfY     = mine->queryY();
+        info.selfKnown = true;
+        return info;
+    }
+
+    // Foreign view: copy it once, recording the self marker if it has one
+    auto snap = std::make_shared<BattleSnapshot>(rows, cols);
+    for (std::size_t y = 0; y < rows; ++y) {
+        for (std::size_t x = 0; x < cols; ++x) {
+            char c = sv.getObjectAt(x, y);
+            snap->cells[y * cols + x] = c;
+            if (c == '%') {
+                info.selfX     = x;
+                info.selfY     = y;
+                info.selfKnown = true;
+            }
+        }
+    }
+    snap->hash    = zobrist::pictureHash(snap->cells.data(), snap->cells.size());
+    info.snapshot = std::move(snap);
+    return info;
+}
+
+void MyBattleInfo::merge(const MyBattleInfo& update) {
+    const std::size_t oldRows = rows, oldCols = cols;
+    rows            = update.rows;
+    cols            = update.cols;
+    selfX           = update.selfX;
+    selfY           = update.selfY;
+    selfKnown       = update.selfKnown;
+    shellsRemaining = update.shellsRemaining;
+    danger          = update.danger;
+    flow            = update.flow;
+    if (!update.delta) {
+        snapshot = update.snapshot;
+        return;
+    }
+
+    std::shared_ptr<BattleSnapshot> grid;
+    if (!snapshot || oldRows != rows || oldCols != cols)
+        grid = std::make_shared<BattleSnapshot>(rows, cols);
+    else if (snapshot.use_count() == 1)
+        grid = std::const_pointer_cast<BattleSnapshot>(snapshot);   // ours alone
+    else
+        grid = std::make_shared<BattleSnapshot>(*snapshot);
+    for (const CellChange& ch : update.changes) {
+        char& c = grid->cells[ch.cell];
+        grid->hash ^= zobrist::cellKey(ch.cell, c) ^ zobrist::cellKey(ch.cell, ch.c);
+        c = ch.c;
+    }
+    snapshot = std::move(grid);
+}
+
+void MyBattleInfo::save(CheckpointWriter& out) const {
+    out.putU(rows);
+    out.putU(cols);
+    out.putSnapshot(snapshot);
+    out.putU(selfX);
+    out.putU(selfY);
+    out.putBool(selfKnown);
+    out.putU(shellsRemaining);
+}
+
+std::uint64_t MyBattleInfo::stateHash() const {
+    std::uint64_t h = zobrist::combine(rows, cols);
+    h = zobrist::combine(h, snapshot ? snapshot->hash : ~std::uint64_t(0));
+    h = zobrist::combine(h, selfX);
+    h = zobrist::combine(h, selfY);
+    h = zobrist::combine(h, std::uint64_t(selfKnown));
+    return zobrist::combine(h, shellsRemaining);
+}
+
+bool MyBattleInfo::load(CheckpointReader& in) {
+    rows            = in.getU();
+    cols            = in.getU();
+    snapshot        = in.getSnapshot();
+    selfX           = in.getU();
+    selfY           = in.getU();
+    selfKnown       = in.getBool();
+    shellsRemaining = in.getU();
+    return in.ok();
+}
@@ -0,0 +1,73 @@
+// src/PhaseTimes.cpp
+#include "PhaseTimes.h"
+
+#include <bit>
+#include <ostream>
+#include <string>
+
+using namespace arena;
+
+void Log2Histogram::add(std::uint64_t v) {
+    std::size_t b = v ? std::size_t(std::bit_width(v)) - 1 : 0;
+    if (b >= BUCKETS) b = BUCKETS - 1;
+    ++counts[b];
+}
+
+std::uint64_t Log2Histogram::quantile(double q) const {
+    std::uint64_t n = 0;
+    for (auto c : counts) n += c;
+    if (n == 0) return 0;
+    auto rank = std::uint64_t(q * double(n - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < BUCKETS; ++b) {
+        seen += counts[b];
+        if (seen >= rank) return (std::uint64_t(2) << b) - 1;
+    }
+    return (std::uint64_t(2) << (BUCKETS - 1)) - 1;
+}
+
+//------------------------------------------------------------------------------
+namespace {
+
+template <typename Fn>
+void forEachStat(const PhaseTimes& t, Fn&& fn) {
+    for (std::size_t p = 0; p < TURN_PHASE_COUNT; ++p)
+        fn(std::string("phase_ns.") + phaseName(TurnPhase(p)), t.phase[p]);
+    fn("turn_ns",             t.turnNanos);
+    fn("count.tanks_alive",   t.tanksAlive);
+    fn("count.shells",        t.shells);
+    fn("count.info_requests", t.infoRequests);
+}
+
+double mean(const TurnStat& s, std::uint64_t turns) {
+    return turns ? double(s.total) / double(turns) : 0.0;
+}
+
+} // namespace
+
+void PhaseTimes::writeCsv(std::ostream& os) const {
+    os << "metric,turns,total,mean,max,p50,p90,p99\n";
+    forEachStat(*this, [&](const std::string& name, const TurnStat& s) {
+        os << name << ',' << turns << ',' << s.total << ',' << mean(s, turns) << ','
+           << s.max << ',' << s.hist.quantile(0.5) << ',' << s.hist.quantile(0.9) << ','
+           << s.hist.quantile(0.99) << '\n';
+    });
+}
+
+void PhaseTimes::writeJson(std::ostream& os) const {
+    os << "{\n  \"turns\": " << turns << ",\n  \"metrics\": {\n";
+    bool first = true;
+    forEachStat(*this, [&](const std::string& name, const TurnStat& s) {
+        os << (first ? "" : ",\n") << "    \"" << name << "\": {\"total\": " << s.total
+           << ", \"mean\": " << mean(s, turns) << ", \"max\": " << s.max
+           << ", \"p50\": " << s.hist.quantile(0.5) << ", \"p90\": " << s.hist.quantile(0.9)
+           << ", \"p99\": " << s.hist.quantile(0.99) << ", \"log2_histogram\": [";
+        std::size_t last = Log2Histogram::BUCKETS;
+        while (last > 0 && s.hist.counts[last - 1] == 0) --last;
+        for (std::size_t b = 0; b < last; ++b)
+            os << (b ? ", " : "") << s.hist.counts[b];
+        os << "]}";
+        first = false;
+    });
+    os << "\n  }\n}\n";
+}
@@ -7,39 +7,43 @@ Player1::Player1(int /*player_index*/,
                  std::size_t rows,
                  std::size_t cols,
                  std::size_t /*max_steps*/,
-                 std::size_t num_shells)
+                 std::size_t num_shells,
+                 bool        flowField)
   : rows_(rows)
   , cols_(cols)
   , initialShells_(num_shells)
   , firstInfo_(true)
+  , flowField_(flowField)
 {}
 
 void Player1::updateTankWithBattleInfo(
     TankAlgorithm  &tank,
     SatelliteView  &sv
 ) {
-    // Build our info wrapper
-    MyBattleInfo info(rows_, cols_);
-
-    // Fill grid + self marker
-    for (std::size_t y = 0; y < rows_; ++y) {
-        for (std::size_t x = 0; x < cols_; ++x) {
-            char c = sv.getObjectAt(x, y);
-            info.grid[y][x] = c;
-            if (c == '%') {
-                info.selfX = x;
-                info.selfY = y;
-            }
-        }
-    }
+    // Build our info wrapper (shares the turn snapshot + self marker)
+    MyBattleInfo info = MyBattleInfo::fromView(sv, rows_, cols_);
 
-    // Relay initial shells exactly once:
+    // Relay initial shells exactly once; the engine runs our first update
+    // on its own, so later (concurrent) ones only ever read firstInfo_
     if (firstInfo_) {
         info.shellsRemaining = initialShells_;
         firstInfo_ = false;
     }
     // otherwise leave info.shellsRemaining == 0 (unused)
 
+    // Per-turn fields shared by all our tanks
+    info.danger = danger_.get(sv, info);
+    if (flowField_) info.flow = flow_.get(sv, info, '1');
+
     // Forward to tank algo
     tank.updateBattleInfo(info);
 }
+
+void Player1::saveState(CheckpointWriter& out) const {
+    out.putBool(firstInfo_);
+}
+
+bool Player1::loadState(CheckpointReader& in) {
+    firstInfo_ = in.getBool();
+    return in.ok();
+}
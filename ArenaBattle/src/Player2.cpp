@@ -7,34 +7,39 @@ Player2::Player2(int /*player_index*/,
                  std::size_t rows,
                  std::size_t cols,
                  std::size_t /*max_steps*/,
-                 std::size_t num_shells)
+                 std::size_t num_shells,
+                 bool        flowField)
   : rows_(rows)
   , cols_(cols)
   , initialShells_(num_shells)
   , firstInfo_(true)
+  , flowField_(flowField)
 {}
 
 void Player2::updateTankWithBattleInfo(
     TankAlgorithm  &tank,
     SatelliteView  &sv
 ) {
-    MyBattleInfo info(rows_, cols_);
-
-    for (std::size_t y = 0; y < rows_; ++y) {
-        for (std::size_t x = 0; x < cols_; ++x) {
-            char c = sv.getObjectAt(x, y);
-            info.grid[y][x] = c;
-            if (c == '%') {
-                info.selfX = x;
-                info.selfY = y;
-            }
-        }
-    }
+    MyBattleInfo info = MyBattleInfo::fromView(sv, rows_, cols_);
 
+    // the engine runs our first update on its own, so later (concurrent)
+    // ones only ever read firstInfo_
     if (firstInfo_) {
         info.shellsRemaining = initialShells_;
         firstInfo_ = false;
     }
 
+    info.danger = danger_.get(sv, info);
+    if (flowField_) info.flow = flow_.get(sv, info, '2');
+
     tank.updateBattleInfo(info);
 }
+
+void Player2::saveState(CheckpointWriter& out) const {
+    out.putBool(firstInfo_);
+}
+
+bool Player2::loadState(CheckpointReader& in) {
+    firstInfo_ = in.getBool();
+    return in.ok();
+}
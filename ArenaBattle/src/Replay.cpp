@@ -0,0 +1,158 @@
+// src/Replay.cpp
+#include "Replay.h"
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+
+using namespace arena;
+
+namespace {
+
+constexpr char MAGIC[4]   = {'T', 'K', 'R', 'P'};
+constexpr char TAG_TURN   = 'T';
+constexpr char TAG_RESULT = 'R';
+
+// Never matches a real outcome, so the first turn is written in full.
+constexpr TankOutcome NO_OUTCOME = 0xFF;
+
+bool getVarint(std::istream& in, std::size_t& v) {
+    v = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        int c = in.get();
+        if (c == EOF) return false;
+        v |= std::size_t(c & 0x7F) << shift;
+        if (!(c & 0x80)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+ReplayWriter::ReplayWriter(std::ostream& out, const ReplayHeader& header)
+  : out_(out), prev_(header.tank_count, NO_OUTCOME)
+{
+    buf_.assign(MAGIC, MAGIC + 4);
+    buf_.push_back(char(VERSION));
+    putVarint(header.rows);
+    putVarint(header.cols);
+    putVarint(header.max_steps);
+    putVarint(header.num_shells);
+    putVarint(header.tank_count);
+    putVarint(header.map_name.size());
+    buf_.insert(buf_.end(), header.map_name.begin(), header.map_name.end());
+    out_.write(buf_.data(), std::streamsize(buf_.size()));
+}
+
+void ReplayWriter::putVarint(std::size_t v) {
+    while (v >= 0x80) {
+        buf_.push_back(char((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    buf_.push_back(char(v));
+}
+
+void ReplayWriter::writeTurn(const std::vector<TankOutcome>& outcomes) {
+    buf_.clear();
+    buf_.push_back(TAG_TURN);
+    const std::size_t N = prev_.size();
+    std::size_t k = 0;
+    while (k < N) {
+        std::size_t skip = 0, lit = 0;
+        while (k + skip < N && outcomes[k + skip] == prev_[k + skip]) ++skip;
+        while (k + skip + lit < N && outcomes[k + skip + lit] != prev_[k + skip + lit]) ++lit;
+        putVarint(skip);
+        putVarint(lit);
+        for (std::size_t i = k + skip; i < k + skip + lit; ++i) {
+            buf_.push_back(char(outcomes[i]));
+            prev_[i] = outcomes[i];
+        }
+        k += skip + lit;
+    }
+    out_.write(buf_.data(), std::streamsize(buf_.size()));
+}
+
+void ReplayWriter::writeResult(const std::string& result) {
+    buf_.clear();
+    buf_.push_back(TAG_RESULT);
+    putVarint(result.size());
+    buf_.insert(buf_.end(), result.begin(), result.end());
+    out_.write(buf_.data(), std::streamsize(buf_.size()));
+}
+
+//------------------------------------------------------------------------------
+bool arena::replayToText(std::istream& in, std::ostream& out, std::string& error) {
+    char magic[4];
+    if (!in.read(magic, 4) || !std::equal(magic, magic + 4, MAGIC)) {
+        error = "not a replay file";
+        return false;
+    }
+    int version = in.get();
+    if (version != ReplayWriter::VERSION) {
+        error = "unsupported replay version " + std::to_string(version);
+        return false;
+    }
+
+    ReplayHeader h;
+    std::size_t nameLen = 0;
+    if (!getVarint(in, h.rows) || !getVarint(in, h.cols) ||
+        !getVarint(in, h.max_steps) || !getVarint(in, h.num_shells) ||
+        !getVarint(in, h.tank_count) || !getVarint(in, nameLen))
+    {
+        error = "truncated replay header";
+        return false;
+    }
+    h.map_name.resize(nameLen);
+    if (nameLen && !in.read(h.map_name.data(), std::streamsize(nameLen))) {
+        error = "truncated replay header";
+        return false;
+    }
+
+    std::vector<TankOutcome> outcomes(h.tank_count, NO_OUTCOME);
+    std::string line;
+    for (int tag = in.get(); tag != EOF; tag = in.get()) {
+        if (tag == TAG_TURN) {
+            std::size_t k = 0;
+            while (k < outcomes.size()) {
+                std::size_t skip = 0, lit = 0;
+                if (!getVarint(in, skip) || !getVarint(in, lit) ||
+                    k + skip + lit > outcomes.size())
+                {
+                    error = "corrupt turn record";
+                    return false;
+                }
+                k += skip;
+                for (; lit > 0; --lit, ++k) {
+                    int c = in.get();
+                    if (c == EOF) {
+                        error = "truncated turn record";
+                        return false;
+                    }
+                    outcomes[k] = TankOutcome(c);
+                }
+            }
+            line.clear();
+            appendTurnLine(line, outcomes);
+            line += '\n';
+            out << line;
+        } else if (tag == TAG_RESULT) {
+            std::size_t len = 0;
+            std::string result;
+            if (!getVarint(in, len)) {
+                error = "truncated result record";
+                return false;
+            }
+            result.resize(len);
+            if (len && !in.read(result.data(), std::streamsize(len))) {
+                error = "truncated result record";
+                return false;
+            }
+            out << result << "\n";
+        } else {
+            error = "unknown record tag " + std::to_string(tag);
+            return false;
+        }
+    }
+    return true;
+}
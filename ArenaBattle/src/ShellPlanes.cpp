@@ -0,0 +1,164 @@
+// src/ShellPlanes.cpp
+#include "ShellPlanes.h"
+
+#include <bit>
+
+using namespace arena;
+
+namespace {
+constexpr int DX[8] = {0,1,1,1,0,-1,-1,-1};
+constexpr int DY[8] = {-1,-1,0,1,1,1,0,-1};
+}
+
+void ShellPlanes::reset(const Board& board) {
+    rows_ = board.getRows();
+    cols_ = board.getCols();
+    for (BitPlane* p : {&walls_, &damaged_, &tanks_, &nextWalls_, &nextDamaged_, &nextTanks_,
+                        &shifted_, &visitedOnce_, &visitedTwice_})
+        p->reset(rows_, cols_);
+    for (int d = 0; d < 8; ++d) {
+        start_[d].reset(rows_, cols_);
+        step_[d].reset(rows_, cols_);
+    }
+    shellAt_.assign(rows_ * cols_, 0);
+    clashes_.clear();
+    clashes_.reserve(walls_.wordCount());   // at most one per word and sub-step
+    for (std::size_t y = 0; y < rows_; ++y) {
+        const Cell* row = board.row(y);
+        for (std::size_t x = 0; x < cols_; ++x)
+            update(int(x), int(y), row[x]);
+    }
+}
+
+void ShellPlanes::update(int x, int y, const Cell& cell) {
+    const CellContent c = cell.content();
+    if (c == CellContent::WALL) {
+        walls_.set(x, y);
+        if (cell.wallHits() > 0) damaged_.set(x, y);
+        else                     damaged_.clear(x, y);
+    } else {
+        walls_.clear(x, y);
+        damaged_.clear(x, y);
+    }
+    if (c == CellContent::TANK1 || c == CellContent::TANK2) tanks_.set(x, y);
+    else                                                    tanks_.clear(x, y);
+}
+
+//------------------------------------------------------------------------------
+bool ShellPlanes::plan(const ShellPool& shells) {
+    if (rows_ < 4 || cols_ < 4) return false;
+
+    for (BitPlane& p : start_) p.clearAll();
+    for (std::size_t i = 0; i < shells.size(); ++i) {
+        const Shell& s = shells[i];
+        if (start_[s.dir].testAndSet(s.x, s.y)) return false;   // stacked, same direction
+        shellAt_[std::size_t(s.y) * cols_ + std::size_t(s.x)] = std::uint32_t(i);
+    }
+
+    // Crossings: step_[d] marks the cells whose d-neighbour holds a shell
+    // flying the opposite way. A d-shell there and that shell swap cells
+    // in the first sub-step, so both stop where they are.
+    for (int d = 0; d < 8; ++d) {
+        const int o = (d + 4) % 8;
+        step_[d].shiftFrom(start_[o], DX[o], DY[o]);
+    }
+    std::uint64_t* start[8];
+    const std::uint64_t* facing[8];
+    for (int d = 0; d < 8; ++d) { start[d] = start_[d].words(); facing[d] = step_[d].words(); }
+    for (std::size_t w = 0, n = walls_.wordCount(); w < n; ++w) {
+        std::uint64_t in1 = 0, in2 = 0;
+        for (auto* p : start) { in2 |= in1 & p[w]; in1 |= p[w]; }
+        if (in2) return false;   // stacked, different directions
+        for (int d = 0; d < 8; ++d) start[d][w] &= ~facing[d][w];
+    }
+
+    nextWalls_   = walls_;
+    nextDamaged_ = damaged_;
+    nextTanks_   = tanks_;
+    visitedOnce_.clearAll();
+    visitedTwice_.clearAll();
+    subStep(1);
+    subStep(2);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Moves every live shell one cell (`back` = sub-steps since its start cell)
+// and resolves what it enters.
+void ShellPlanes::subStep(int back) {
+    for (int d = 0; d < 8; ++d) {
+        if (back == 1) {
+            step_[d].shiftFrom(start_[d], DX[d], DY[d]);
+        } else {
+            shifted_.shiftFrom(step_[d], DX[d], DY[d]);
+            step_[d].swap(shifted_);
+        }
+    }
+
+    std::uint64_t* step[8];
+    for (int d = 0; d < 8; ++d) step[d] = step_[d].words();
+    std::uint64_t* walls   = nextWalls_.words();
+    std::uint64_t* damaged = nextDamaged_.words();
+    std::uint64_t* tanks   = nextTanks_.words();
+    std::uint64_t* once    = visitedOnce_.words();
+    std::uint64_t* twice   = visitedTwice_.words();
+    clashes_.clear();
+    for (std::size_t w = 0, n = nextWalls_.wordCount(); w < n; ++w) {
+        std::uint64_t in1 = 0, in2 = 0;   // entered by one shell or more, by two or more
+        for (auto* p : step) { in2 |= in1 & p[w]; in1 |= p[w]; }
+        if (!in1) continue;
+
+        const std::uint64_t blocker = walls[w] | tanks[w];
+        const std::uint64_t hit     = in1 & blocker;
+        const std::uint64_t clash   = in2 & blocker;
+        if (clash) clashes_.push_back({w, clash, clash & (tanks[w] | damaged[w])});
+        // a lone shell dies on what it enters
+        if (const std::uint64_t lone = hit & ~clash)
+            for (auto* p : step) p[w] &= ~lone;
+        // a tank goes at its first hit, a wall at its second
+        const std::uint64_t gone = hit & (tanks[w] | damaged[w] | in2);
+        tanks[w]   &= ~hit;
+        walls[w]   &= ~gone;
+        damaged[w]  = (damaged[w] | hit) & walls[w];
+        // shells entering open cells pass through them
+        const std::uint64_t pass1 = in1 & ~blocker, pass2 = in2 & ~blocker;
+        twice[w] |= pass2 | (once[w] & pass1);
+        once[w]  |= pass1;
+    }
+    settleClashes(back);
+}
+
+// A blocker entered by k >= 2 shells in one sub-step stops the lowest one
+// or two of them by shell index (two for an undamaged wall) and is gone
+// before the others reach it, so they pass through its cell.
+void ShellPlanes::settleClashes(int back) {
+    const std::size_t rowWords = (cols_ + 63) / 64;
+    const int R = int(rows_), C = int(cols_);
+    for (const Clash& clash : clashes_) {
+        const int y  = int(clash.word / rowWords);
+        const int x0 = int(clash.word % rowWords) * 64;
+        for (std::uint64_t cells = clash.cells; cells != 0; cells &= cells - 1) {
+            const int bit = std::countr_zero(cells);
+            const int x   = x0 + bit;
+            // the shells that came in, by shell index
+            std::uint32_t who[8];
+            int           dirOf[8];
+            int           k = 0;
+            for (int d = 0; d < 8; ++d) {
+                if (!step_[d].test(x, y)) continue;
+                const int sx = (x - back * DX[d] + 2 * C) % C;
+                const int sy = (y - back * DY[d] + 2 * R) % R;
+                const std::uint32_t i = shellAt_[std::size_t(sy) * cols_ + std::size_t(sx)];
+                int j = k++;
+                for (; j > 0 && who[j - 1] > i; --j) { who[j] = who[j - 1]; dirOf[j] = dirOf[j - 1]; }
+                who[j]   = i;
+                dirOf[j] = d;
+            }
+            const int stopped = (clash.single >> bit) & 1 ? 1 : 2;
+            for (int j = 0; j < stopped; ++j) step_[dirOf[j]].clear(x, y);
+            const int through = k - stopped;
+            if (through >= 2 || (through == 1 && visitedOnce_.test(x, y))) visitedTwice_.set(x, y);
+            if (through >= 1) visitedOnce_.set(x, y);
+        }
+    }
+}
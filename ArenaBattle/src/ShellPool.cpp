@@ -0,0 +1,22 @@
+// src/ShellPool.cpp
+#include "ShellPool.h"
+
+#include <algorithm>
+
+using namespace arena;
+
+void ShellPool::compact() {
+    std::size_t out = 0;
+    for (std::size_t w = 0; w < dead_.size(); ++w) {
+        // skip whole words of survivors that are already in place
+        if (dead_[w] == 0 && out == w * 64) {
+            out = std::min(shells_.size(), (w + 1) * 64);
+            continue;
+        }
+        const std::size_t end = std::min(shells_.size(), (w + 1) * 64);
+        for (std::size_t i = w * 64; i < end; ++i)
+            if (!((dead_[w] >> (i & 63)) & 1)) shells_[out++] = shells_[i];
+        dead_[w] = 0;
+    }
+    shells_.resize(out);
+}
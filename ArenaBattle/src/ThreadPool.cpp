@@ -0,0 +1,99 @@
+// src/ThreadPool.cpp
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+using namespace arena;
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t i = 0; i < threads; ++i)
+        queues_.push_back(std::make_unique<Queue>());
+    for (std::size_t i = 0; i < threads; ++i)
+        workers_.emplace_back([this, i] { workerLoop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        stop_ = true;
+    }
+    workCv_.notify_all();
+    for (auto& t : workers_) t.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    std::size_t q = nextQueue_.fetch_add(1) % queues_.size();
+    {
+        std::lock_guard<std::mutex> lk(queues_[q]->mtx);
+        queues_[q]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        ++queued_;
+        ++pending_;
+    }
+    workCv_.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lk(mtx_);
+    doneCv_.wait(lk, [this] { return pending_ == 0; });
+}
+
+void ThreadPool::parallelFor(std::size_t n, const std::function<void(std::size_t)>& fn) {
+    // a few chunks per worker so stealing can even out uneven items
+    const std::size_t chunks = std::min(n, workers_.size() * 4);
+    for (std::size_t c = 0; c < chunks; ++c) {
+        const std::size_t begin = n * c / chunks, end = n * (c + 1) / chunks;
+        submit([&fn, begin, end] {
+            for (std::size_t i = begin; i < end; ++i) fn(i);
+        });
+    }
+    wait();
+}
+
+bool ThreadPool::tryPop(std::size_t self, std::function<void()>& task) {
+    // own queue, newest first
+    {
+        Queue& q = *queues_[self];
+        std::lock_guard<std::mutex> lk(q.mtx);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            return true;
+        }
+    }
+    // steal the oldest task of another worker
+    for (std::size_t i = 1; i < queues_.size(); ++i) {
+        Queue& q = *queues_[(self + i) % queues_.size()];
+        std::lock_guard<std::mutex> lk(q.mtx);
+        if (!q.tasks.empty()) {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(std::size_t self) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lk(mtx_);
+            workCv_.wait(lk, [this] { return stop_ || queued_ > 0; });
+            if (queued_ == 0) return;   // stopping and nothing left
+            --queued_;                  // reserve one task
+        }
+        std::function<void()> task;
+        while (!tryPop(self, task)) {
+            // the reserved task is being pushed right now; retry
+            std::this_thread::yield();
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (--pending_ == 0) doneCv_.notify_all();
+        }
+    }
+}
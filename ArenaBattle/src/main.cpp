@@ -2,70 +2,212 @@
 #include "utils.h"
 #include "MyPlayerFactory.h"
 #include "MyTankAlgorithmFactory.h"
+#include "Replay.h"
+#include "BatchRunner.h"
+#include "Log.h"
 
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace arena;
 
-int main(int argc, char** argv) {
-    if (argc < 2) {
-        std::cerr << "Usage: tanks_game <input_file>\n";
+// tanks_game --replay-to-text <replay> [out.txt]
+static int convertReplay(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: tanks_game --replay-to-text <replay_file> [output_file]\n";
         return 1;
     }
-    const std::string map_file = argv[1];
-
-    std::ifstream in(map_file);
+    std::ifstream in(argv[2], std::ios::binary);
     if (!in) {
-        std::cerr << "Cannot open map file: " << map_file << "\n";
+        std::cerr << "Cannot open replay file: " << argv[2] << "\n";
         return 1;
     }
-
-    std::string line;
-    std::size_t max_steps = 0, num_shells = 0, rows = 0, cols = 0;
-
-    // 1) Line 1: title (ignored, but must exist)
-    if (!std::getline(in, line)) {
-        std::cerr << "Invalid map file: missing title line\n";
-        return 1;
+    std::ofstream file;
+    if (argc > 3) {
+        file.open(argv[3]);
+        if (!file) {
+            std::cerr << "Cannot open output file: " << argv[3] << "\n";
+            return 1;
+        }
     }
-
-    // 2) Line 2: MaxSteps = <NUM>
-    if (!std::getline(in, line) || !parseKeyValue(line, "MaxSteps", max_steps)) {
-        std::cerr << "Invalid header (MaxSteps): \"" << line << "\"\n";
+    std::string error;
+    if (!replayToText(in, argc > 3 ? file : std::cout, error)) {
+        std::cerr << "Invalid replay file: " << error << "\n";
         return 1;
     }
+    return 0;
+}
 
-    // 3) Line 3: NumShells = <NUM>
-    if (!std::getline(in, line) || !parseKeyValue(line, "NumShells", num_shells)) {
-        std::cerr << "Invalid header (NumShells): \"" << line << "\"\n";
+// tanks_game --batch [--threads N] [--replay] [--stop-cycles] <map_or_dir>...
+static int runBatch(int argc, char** argv) {
+    std::size_t threads = 0;
+    LogFormat   format  = LogFormat::Text;
+    bool        stopCycles = false;
+    std::vector<std::string> paths;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            if (!parseKeyValue(std::string("threads=") + argv[++i], "threads", threads)) {
+                std::cerr << "Invalid thread count: " << argv[i] << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--replay") format = LogFormat::Replay;
+        else if (arg == "--stop-cycles") stopCycles = true;
+        else paths.push_back(arg);
+    }
+    auto maps = BatchRunner::collectMaps(paths);
+    if (maps.empty()) {
+        std::cerr << "Usage: tanks_game --batch [--threads N] [--replay] [--stop-cycles] <map_file_or_dir>...\n";
         return 1;
     }
 
-    // 4) Line 4: Rows = <NUM>
-    if (!std::getline(in, line) || !parseKeyValue(line, "Rows", rows)) {
-        std::cerr << "Invalid header (Rows): \"" << line << "\"\n";
-        return 1;
+    auto start   = std::chrono::steady_clock::now();
+    auto results = BatchRunner(threads, format, stopCycles).run(maps);
+    double wallMillis = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start).count();
+    BatchRunner::printSummary(std::cout, results, wallMillis);
+
+    for (const auto& r : results)
+        if (!r.ok) return 1;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 2 && std::string(argv[1]) == "--replay-to-text")
+        return convertReplay(argc, argv);
+    if (argc >= 2 && std::string(argv[1]) == "--batch")
+        return runBatch(argc, argv);
+
+    // Optional flags: --headless skips all console rendering,
+    //                 --replay writes a binary replay instead of the text log,
+    //                 --decision-threads N gathers tank decisions on N threads
+    //                 --checkpoint-at N <file> saves the game after turn N
+    //                 --resume <file> continues a saved game instead of a map
+    //                 --profile <file.json|file.csv> writes per-phase timings
+    //                 --incremental-replan keeps AggressiveTank plans that are still valid
+    //                 --delta-views sends tanks only the cells changed since their last view
+    //                 --flow-field lets AggressiveTanks plan from one shared per-player field
+    //                 --view-shells shows shells ('*') in satellite views
+    //                 --shell-planes moves shells with whole-board bit operations
+    //                 --stop-cycles ends the game as a tie once its whole state repeats
+    //                 --log-level L filters log lines compiled in (make LOG_LEVEL=N)
+    //                 --log-file <file> writes them there instead of stderr
+    bool headless = false, replay = false, incremental = false, delta_views = false;
+    bool flow_field = false, stop_cycles = false, shell_planes = false;
+    bool view_shells = false;
+    std::size_t decision_threads = 1, checkpoint_turn = 0;
+    std::string map_file, checkpoint_file, resume_file, profile_file, log_file;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--headless") headless = true;
+        else if (arg == "--replay") replay = true;
+        else if (arg == "--incremental-replan") incremental = true;
+        else if (arg == "--delta-views") delta_views = true;
+        else if (arg == "--flow-field") flow_field = true;
+        else if (arg == "--stop-cycles") stop_cycles = true;
+        else if (arg == "--shell-planes") shell_planes = true;
+        else if (arg == "--view-shells") view_shells = true;
+        else if (arg == "--decision-threads" && i + 1 < argc) {
+            if (!parseKeyValue(std::string("threads=") + argv[++i], "threads", decision_threads)) {
+                std::cerr << "Invalid thread count: " << argv[i] << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--checkpoint-at" && i + 2 < argc) {
+            if (!parseKeyValue(std::string("turn=") + argv[++i], "turn", checkpoint_turn) ||
+                checkpoint_turn == 0) {
+                std::cerr << "Invalid checkpoint turn: " << argv[i] << "\n";
+                return 1;
+            }
+            checkpoint_file = argv[++i];
+        }
+        else if (arg == "--resume" && i + 1 < argc) resume_file = argv[++i];
+        else if (arg == "--profile" && i + 1 < argc) profile_file = argv[++i];
+        else if (arg == "--log-level" && i + 1 < argc) {
+            LogLevel level;
+            if (!parseLogLevel(argv[++i], level)) {
+                std::cerr << "Invalid log level: " << argv[i]
+                          << " (off, error, warn, info, debug, trace)\n";
+                return 1;
+            }
+            setLogLevel(level);
+        }
+        else if (arg == "--log-file" && i + 1 < argc) log_file = argv[++i];
+        else if (map_file.empty()) map_file = arg;
     }
 
-    // 5) Line 5: Cols = <NUM>
-    if (!std::getline(in, line) || !parseKeyValue(line, "Cols", cols)) {
-        std::cerr << "Invalid header (Cols): \"" << line << "\"\n";
-        return 1;
+    std::ofstream log_out;
+    if (!log_file.empty()) {
+        log_out.open(log_file);
+        if (!log_out) {
+            std::cerr << "Cannot open log file: " << log_file << "\n";
+            return 1;
+        }
+        setLogSink(&log_out);
     }
+    // log_out dies with main(), so hand the sink back before that
+    struct LogSinkReset {
+        ~LogSinkReset() { setLogSink(nullptr); }
+    } log_sink_reset;
+
+    auto configure = [&](GameManager& gm) {
+        if (headless) gm.setObserver(std::make_unique<NullObserver>());
+        if (replay)   gm.setLogFormat(LogFormat::Replay);
+        gm.setDecisionThreads(decision_threads);
+        gm.setDeltaViews(delta_views);
+        gm.setCycleDetection(stop_cycles);
+        gm.setShellPlanes(shell_planes);
+        gm.setShellsInViews(view_shells);
+        if (checkpoint_turn) gm.setCheckpointAt(checkpoint_turn, checkpoint_file);
+        if (!profile_file.empty()) gm.setProfileOutput(profile_file);
+    };
 
-    in.close();
+    if (!resume_file.empty()) {
+        GameManager gm(std::make_unique<MyPlayerFactory>(flow_field),
+                       std::make_unique<common::MyTankAlgorithmFactory>(incremental));
+        configure(gm);
+        std::string error;
+        if (!gm.loadCheckpoint(resume_file, error)) {
+            std::cerr << "Cannot resume: " << error << "\n";
+            return 1;
+        }
+        if (!gm.run(error)) {
+            std::cerr << "Error: " << error << "\n";
+            return 1;
+        }
+        return 0;
+    }
 
-    // Build the two factories with the parsed parameters
-    auto playerFac = std::make_unique<MyPlayerFactory>();
-    auto tankFac   = std::make_unique<common::MyTankAlgorithmFactory>();
+    if (map_file.empty()) {
+        std::cerr << "Usage: tanks_game [--headless] [--replay] [--decision-threads N]\n"
+                  << "                  [--checkpoint-at N <checkpoint_file>] [--incremental-replan]\n"
+                  << "                  [--delta-views] [--flow-field] [--stop-cycles]\n"
+                  << "                  [--shell-planes] [--view-shells] [--log-level L]\n"
+                  << "                  [--log-file <file>] [--profile <file.json|file.csv>] <input_file>\n"
+                  << "       tanks_game [--headless] [--replay] --resume <checkpoint_file>\n"
+                  << "       tanks_game --replay-to-text <replay_file> [output_file]\n"
+                  << "       tanks_game --batch [--threads N] [--replay] [--stop-cycles] <map_file_or_dir>...\n";
+        return 1;
+    }
 
-    // Construct, initialize, and run:
-    GameManager gm(std::move(playerFac), std::move(tankFac));
-    gm.readBoard(map_file);
-    gm.run();
+    // Construct, load, and run:
+    GameManager gm(std::make_unique<MyPlayerFactory>(flow_field),
+                   std::make_unique<common::MyTankAlgorithmFactory>(incremental));
+    configure(gm);
+    std::string error;
+    if (!gm.readBoard(map_file, error)) {
+        std::cerr << error << "\n";
+        return 1;
+    }
+    if (!gm.run(error)) {
+        std::cerr << "Error: " << error << "\n";
+        return 1;
+    }
 
     return 0;
 }
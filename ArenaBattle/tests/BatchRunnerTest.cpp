@@ -0,0 +1,62 @@
+// tests/BatchRunnerTest.cpp
+#include "Test.h"
+
+#include "BatchRunner.h"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace arena;
+
+// Neither map exists, so nothing is played or written; only the second is
+// turned away for its output name.
+TEST(batch_rejects_clashing_output_names) {
+    BatchRunner runner(1);
+    auto results = runner.run({"no_such_dir_a/map.txt", "no_such_dir_b/map.txt",
+                               "no_such_dir_b/map.dat", "no_such_dir_a/other.txt"});
+    REQUIRE(results.size() == 4);
+    CHECK(!results[0].ok);
+    CHECK(results[0].result.find("same output name") == std::string::npos);
+    CHECK(results[1].result == "error: same output name as no_such_dir_a/map.txt, not played");
+    CHECK(results[2].result == "error: same output name as no_such_dir_a/map.txt, not played");
+    CHECK(results[3].result.find("same output name") == std::string::npos);
+}
+
+// A log that cannot be opened fails that map only; the batch goes on.
+TEST(batch_reports_unwritable_log_as_failed_map) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "batch_runner_test_logs";
+    fs::create_directories(dir);
+    for (const char* name : {"blocked", "open"}) {
+        std::ofstream(dir / (std::string(name) + ".txt"))
+            << name << "\nMaxSteps = 5\nNumShells = 1\nRows = 3\nCols = 3\n1..\n...\n..2\n";
+    }
+    fs::create_directory("output_blocked.txt");   // where the log would go
+
+    auto results = BatchRunner(2).run({(dir / "blocked.txt").string(), (dir / "open.txt").string()});
+    fs::remove("output_blocked.txt");
+    fs::remove("output_open.txt");
+    fs::remove_all(dir);
+
+    REQUIRE(results.size() == 2);
+    CHECK(!results[0].ok);
+    CHECK(results[0].result ==
+          "error: cannot open actions log file 'output_blocked.txt' for writing");
+    CHECK(results[1].ok);
+}
+
+// Logs of earlier runs next to the maps are not taken for maps.
+TEST(batch_skips_old_logs_in_directories) {
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "batch_runner_test_collect";
+    fs::create_directories(dir);
+    for (const char* name : {"b.txt", "a.txt", "output_a.txt", "notes.md"})
+        std::ofstream(dir / name) << "x\n";
+    auto maps = BatchRunner::collectMaps({dir.string(), "output_kept.txt"});
+    fs::remove_all(dir);
+
+    REQUIRE(maps.size() == 3);
+    CHECK(maps[0] == (dir / "a.txt").string());
+    CHECK(maps[1] == (dir / "b.txt").string());
+    CHECK(maps[2] == "output_kept.txt");   // named explicitly
+}
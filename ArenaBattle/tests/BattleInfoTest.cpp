@@ -0,0 +1,66 @@
+// tests/BattleInfoTest.cpp
+#include "Test.h"
+
+#include "AggressiveTank.h"
+#include "EvasiveTank.h"
+#include "MyBattleInfo.h"
+
+#include <string>
+
+using namespace arena;
+using common::ActionRequest;
+
+namespace {
+
+/// A SatelliteView that is not ours, over a row-major picture.
+class PictureView : public common::SatelliteView {
+public:
+    PictureView(std::string cells, std::size_t cols) : cells_(std::move(cells)), cols_(cols) {}
+    char getObjectAt(std::size_t x, std::size_t y) const override {
+        return cells_[y * cols_ + x];
+    }
+private:
+    std::string cells_;
+    std::size_t cols_;
+};
+
+} // namespace
+
+TEST(foreign_view_finds_the_self_marker) {
+    PictureView view("#..."
+                     "..%."
+                     "...2", 4);
+    MyBattleInfo info = MyBattleInfo::fromView(view, 3, 4);
+    CHECK(info.selfKnown);
+    CHECK(info.selfX == 2 && info.selfY == 1);
+    CHECK(info.at(2, 1) == '%');
+    CHECK(info.at(0, 0) == '#');
+}
+
+// Without a '%' the position is unknown, not (0,0).
+TEST(foreign_view_without_marker_leaves_position_unknown) {
+    PictureView view("#..."
+                     "...."
+                     "...2", 4);
+    MyBattleInfo info = MyBattleInfo::fromView(view, 3, 4);
+    CHECK(!info.selfKnown);
+    CHECK(info.at(0, 0) == '#');
+    for (std::size_t y = 0; y < 3; ++y)
+        for (std::size_t x = 0; x < 4; ++x) CHECK(info.at(x, y) != '%');
+}
+
+// Tanks with no position keep asking for a view instead of acting on one.
+TEST(tanks_ask_again_when_position_unknown) {
+    PictureView view("#..."
+                     "...."
+                     "...2", 4);
+    AggressiveTank aggressive(1, 0);
+    EvasiveTank    evasive(1, 0);
+    for (common::TankAlgorithm* tank : {static_cast<common::TankAlgorithm*>(&aggressive),
+                                        static_cast<common::TankAlgorithm*>(&evasive)}) {
+        CHECK(tank->getAction() == ActionRequest::GetBattleInfo);
+        MyBattleInfo info = MyBattleInfo::fromView(view, 3, 4);
+        tank->updateBattleInfo(info);
+        CHECK(tank->getAction() == ActionRequest::GetBattleInfo);
+    }
+}
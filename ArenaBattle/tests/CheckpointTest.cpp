@@ -0,0 +1,108 @@
+// tests/CheckpointTest.cpp
+#include "Test.h"
+
+#include "Checkpoint.h"
+#include "GameState.h"
+#include "MapLoader.h"
+#include "MyPlayerFactory.h"
+#include "MyTankAlgorithmFactory.h"
+
+#include <sstream>
+
+using namespace arena;
+
+namespace {
+
+const char* const CROWDED_MAP =
+    "crowded\n"
+    "MaxSteps = 500\n"
+    "NumShells = 5\n"
+    "Rows = 8\n"
+    "Cols = 8\n"
+    "###1122#\n"
+    "1...#2#1\n"
+    ".#1@11.@\n"
+    "12121222\n"
+    "1#112#12\n"
+    "2###11#2\n"
+    "22..112.\n"
+    "#212#11#\n";
+
+// Walled-in tanks with no shells: the game soon repeats.
+const char* const CYCLING_MAP =
+    "cycling\n"
+    "MaxSteps = 500\n"
+    "NumShells = 0\n"
+    "Rows = 5\n"
+    "Cols = 7\n"
+    "#######\n"
+    "#1.#.2#\n"
+    "#..#..#\n"
+    "#..#..#\n"
+    "#######\n";
+
+std::unique_ptr<GameState> newGame(bool flowField, bool stopCycles) {
+    auto gs = std::make_unique<GameState>(std::make_unique<MyPlayerFactory>(flowField),
+                                          std::make_unique<common::MyTankAlgorithmFactory>());
+    gs->setCycleDetection(stopCycles);
+    return gs;
+}
+
+/// Log line of every turn played, then the result string. With
+/// `checkpoint`, the game is also saved after turn `saveAt`.
+std::vector<std::string> playToEnd(GameState& gs, std::size_t saveAt = 0,
+                                   std::vector<char>* checkpoint = nullptr) {
+    std::vector<std::string> lines;
+    while (!gs.isGameOver()) {
+        lines.push_back(gs.advanceOneTurn());
+        if (checkpoint && gs.getCurrentStep() == saveAt) {
+            CheckpointWriter out;
+            gs.saveCheckpoint(out);
+            *checkpoint = out.data();
+        }
+    }
+    lines.push_back(gs.getResultString());
+    return lines;
+}
+
+/// A game resumed from a checkpoint after turn `at` plays the same turns as
+/// the uninterrupted one.
+void checkResumeMatches(const char* mapText, std::size_t at, bool flowField,
+                        bool stopCycles = false) {
+    std::istringstream in(mapText);
+    MapData map;
+    std::string error;
+    REQUIRE(loadMap(in, map, error));
+
+    auto whole = newGame(flowField, stopCycles);
+    whole->initialize(map.board, map.maxSteps, map.numShells);
+    std::vector<char> saved;
+    std::vector<std::string> lines = playToEnd(*whole, at, &saved);
+    REQUIRE(!saved.empty());
+    std::vector<std::string> expected(lines.begin() + std::ptrdiff_t(at), lines.end());
+
+    auto resumed = newGame(flowField, stopCycles);
+    CheckpointReader reader(saved.data(), saved.size());
+    REQUIRE(resumed->loadCheckpoint(reader, error));
+    CHECK(playToEnd(*resumed) == expected);
+}
+
+} // namespace
+
+TEST(resume_matches_uninterrupted_game) {
+    checkResumeMatches(CROWDED_MAP, 25, false);
+}
+
+// AggressiveTank's FlowField comes from its player and is not saved; the
+// tank has to rebuild it, or it plans differently after a resume.
+TEST(resume_keeps_flow_field_planning) {
+    checkResumeMatches(CROWDED_MAP, 25, true);
+    checkResumeMatches(CROWDED_MAP, 3, true);
+}
+
+// The cycle detector's anchor and window are saved, so a resumed game
+// spots the repeat on the same turn.
+TEST(resume_keeps_cycle_detection) {
+    for (std::size_t at : {1, 2, 3, 5, 8})
+        checkResumeMatches(CYCLING_MAP, at, false, true);
+}
@@ -0,0 +1,104 @@
+// tests/DangerFieldTest.cpp
+#include "Test.h"
+
+#include "Board.h"
+#include "DangerField.h"
+#include "EvasiveTank.h"
+#include "GameState.h"
+#include "MyBattleInfo.h"
+#include "MyPlayerFactory.h"
+#include "MySatelliteView.h"
+#include "MyTankAlgorithmFactory.h"
+#include "Player2.h"
+#include "TurnFieldCache.h"
+
+using namespace arena;
+using common::ActionRequest;
+
+namespace {
+
+constexpr int RIGHT = 2;
+
+struct Mark { std::size_t x, y; char c; };
+
+/// An 8x8 picture with player 2's tank at (3,3) and the given extra cells.
+std::shared_ptr<BattleSnapshot> picture(std::initializer_list<Mark> marks) {
+    auto snap = std::make_shared<BattleSnapshot>(8, 8);
+    snap->cells[3 * 8 + 3] = '2';
+    for (const Mark& m : marks) snap->cells[m.y * 8 + m.x] = m.c;
+    return snap;
+}
+
+/// The EvasiveTank's move after one view of `snap` through its player.
+ActionRequest evasiveMove(const SnapshotPtr& snap) {
+    Player2     player(2, 8, 8, 100, 10);
+    EvasiveTank tank(2, 0);   // faces right
+    CHECK(tank.getAction() == ActionRequest::GetBattleInfo);
+    MySatelliteView view(snap, 3, 3);
+    player.updateTankWithBattleInfo(tank, view);
+    return tank.getAction();
+}
+
+} // namespace
+
+// A shell fired right from (2,4) is at (4,4) after one turn. Only views
+// with setShellsInViews show it.
+TEST(views_show_shells_when_enabled) {
+    Board board(8, 8);
+    board.setCell(0, 0, CellContent::TANK1);
+    board.setCell(7, 7, CellContent::TANK2);
+    for (bool on : {false, true}) {
+        GameState gs(std::make_unique<MyPlayerFactory>(),
+                     std::make_unique<common::MyTankAlgorithmFactory>());
+        gs.initialize(board, 100, 10);
+        gs.setShellsInViews(on);
+        gs.spawnShell(2, 4, RIGHT);
+        gs.playOneTurn();
+        CHECK(gs.buildBattleSnapshot()->at(4, 4) == (on ? '*' : ' '));
+    }
+}
+
+// . . . . . . . .   The shell at (3,5) reaches the tank at (3,3) next
+// . . . . . . . .   tick. Up-right (4,2) is on none of its rays, so the
+// . . . . . . . .   tank turns that way; without the '*' it sees nothing
+// . . . 2 . . . .   and drives on.
+// . . . . . . . .
+// . . . * . . . .
+TEST(evasive_tank_turns_out_of_a_shells_path) {
+    CHECK(evasiveMove(picture({{3, 5, '*'}})) == ActionRequest::RotateLeft45);
+    CHECK(evasiveMove(picture({})) == ActionRequest::MoveForward);
+}
+
+// With walls above, the only safe neighbour is (4,3), straight ahead.
+TEST(evasive_tank_steps_forward_when_facing_the_escape) {
+    CHECK(evasiveMove(picture({{3, 5, '*'}, {3, 2, '#'}, {4, 2, '#'}}))
+          == ActionRequest::MoveForward);
+}
+
+// A new turn recomputes into a field no tank holds any more.
+TEST(turn_field_cache_reuses_released_fields) {
+    auto first = picture({{3, 5, '*'}});
+    first->version = 1;
+    MySatelliteView view1(first, 3, 3);
+    TurnFieldCache<DangerField> cache;
+    auto held = cache.get(view1, MyBattleInfo::fromView(view1, 8, 8));
+    REQUIRE(held && !held->empty());
+    const DangerField* firstField = held.get();
+
+    auto second = picture({});
+    second->version = 2;
+    MySatelliteView view2(second, 3, 3);
+    auto next = cache.get(view2, MyBattleInfo::fromView(view2, 8, 8));
+    CHECK(next.get() != firstField);   // still held
+    CHECK(next->empty());
+    CHECK(!held->empty());
+
+    held.reset();
+    next.reset();
+    auto third = picture({{3, 5, '*'}});
+    third->version = 3;
+    MySatelliteView view3(third, 3, 3);
+    auto reused = cache.get(view3, MyBattleInfo::fromView(view3, 8, 8));
+    CHECK(reused.get() == firstField);
+    CHECK(!reused->empty());
+}
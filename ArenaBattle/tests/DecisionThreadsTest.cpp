@@ -0,0 +1,64 @@
+// tests/DecisionThreadsTest.cpp
+#include "Test.h"
+
+#include "Board.h"
+#include "ConcurrentPlayer.h"
+#include "GameState.h"
+#include "MyPlayerFactory.h"
+#include "MyTankAlgorithmFactory.h"
+
+#include <random>
+
+using namespace arena;
+
+namespace {
+
+/// A random board crowded with tanks of both players.
+Board crowdedBoard(std::mt19937& rng, int rows, int cols) {
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    Board board(rows, cols);
+    for (int y = 0; y < rows; ++y)
+        for (int x = 0; x < cols; ++x) {
+            const double r = u(rng);
+            if (r < 0.15)      board.setCell(x, y, CellContent::WALL);
+            else if (r < 0.17) board.setCell(x, y, CellContent::MINE);
+            else if (r < 0.27) board.setCell(x, y, CellContent::TANK1);
+            else if (r < 0.37) board.setCell(x, y, CellContent::TANK2);
+        }
+    return board;
+}
+
+/// Log line of every turn, then the result string.
+std::vector<std::string> play(const Board& board, std::size_t threads) {
+    GameState gs(std::make_unique<MyPlayerFactory>(true),
+                 std::make_unique<common::MyTankAlgorithmFactory>());
+    gs.initialize(board, 200, 6);
+    gs.setDecisionThreads(threads);
+    gs.setDeltaViews(true);
+    gs.setShellsInViews(true);
+    std::vector<std::string> lines;
+    while (!gs.isGameOver()) lines.push_back(gs.advanceOneTurn());
+    lines.push_back(gs.getResultString());
+    return lines;
+}
+
+} // namespace
+
+// Both players take their tanks' updates concurrently. The initial shells
+// and the per-turn fields must still go the way they do in a serial run.
+TEST(concurrent_players_match_serial_games) {
+    MyPlayerFactory factory(true);
+    auto p1 = factory.create(1, 8, 8, 100, 5);
+    auto p2 = factory.create(2, 8, 8, 100, 5);
+    REQUIRE(dynamic_cast<ConcurrentPlayer*>(p1.get()));
+    REQUIRE(dynamic_cast<ConcurrentPlayer*>(p2.get()));
+
+    std::mt19937 rng(21);
+    std::uniform_int_distribution<int> side(6, 24);
+    for (int game = 0; game < 12; ++game) {
+        Board board = crowdedBoard(rng, side(rng), side(rng));
+        const auto serial = play(board, 1);
+        CHECK(play(board, 4) == serial);
+        CHECK(play(board, 8) == serial);
+    }
+}
@@ -0,0 +1,73 @@
+// tests/FlowFieldTest.cpp
+#include "Test.h"
+
+#include "Board.h"
+#include "FlowField.h"
+#include "GameState.h"
+#include "MyBattleInfo.h"
+#include "MyPlayerFactory.h"
+#include "MySatelliteView.h"
+#include "MyTankAlgorithmFactory.h"
+#include "TurnFieldCache.h"
+
+using namespace arena;
+using common::ActionRequest;
+
+namespace {
+
+// Directions as in the engine: 0 = up, then clockwise in 45° steps.
+constexpr int RIGHT = 2, DOWN_RIGHT = 3, DOWN = 4;
+
+/// The engine's picture of `board` as a tank at (qx, qy) gets it.
+MySatelliteView engineView(const Board& board, std::size_t qx, std::size_t qy) {
+    GameState gs(std::make_unique<MyPlayerFactory>(),
+                 std::make_unique<common::MyTankAlgorithmFactory>());
+    gs.initialize(board, 100, 10);
+    return MySatelliteView(gs.buildBattleSnapshot(), qx, qy);
+}
+
+} // namespace
+
+// 1 . . . .     Player 1 at (0,0) sees no enemy along any ray. The engine
+// . # 2 . .     draws empty cells as ' ', so they must count as open for the
+// . . . . .     tank to plan a path at all.
+TEST(flow_field_walks_blank_cells) {
+    Board board(3, 5);
+    board.setCell(0, 0, CellContent::TANK1);
+    board.setCell(1, 1, CellContent::WALL);
+    board.setCell(2, 1, CellContent::TANK2);
+    MySatelliteView view = engineView(board, 0, 0);
+    REQUIRE(view.snapshot()->at(3, 0) == ' ');
+
+    MyBattleInfo info = MyBattleInfo::fromView(view, 3, 5);
+    TurnFieldCache<FlowField> cache;
+    auto flow = cache.get(view, info, '1');
+    REQUIRE(flow);
+
+    CHECK(flow->distance(1, 0, DOWN_RIGHT) == 0);   // (2,1) is in the line of fire
+    CHECK(flow->wallsAhead(1, 0, DOWN_RIGHT) == 0);
+    CHECK(flow->distance(0, 1, RIGHT) == 0);        // through the wall at (1,1)
+    CHECK(flow->wallsAhead(0, 1, RIGHT) == 1);
+    CHECK(flow->distance(1, 0, RIGHT) == 1);        // turn right 45°
+    CHECK(flow->distance(0, 0, RIGHT) == 2);        // step onto (1,0), then turn
+    CHECK(flow->next(0, 0, RIGHT) == ActionRequest::MoveForward);
+    CHECK(flow->distance(0, 0, DOWN) == 2);         // step onto (0,1), then turn left 90°
+    CHECK(flow->next(1, 0, DOWN_RIGHT) == ActionRequest::Shoot);
+}
+
+// Our own tank in the line of fire is not a target, and stops the ray.
+TEST(flow_field_skips_own_tanks) {
+    Board board(1, 5);
+    board.setCell(0, 0, CellContent::TANK1);
+    board.setCell(2, 0, CellContent::TANK1);
+    board.setCell(4, 0, CellContent::TANK2);
+    MySatelliteView view = engineView(board, 0, 0);
+
+    FlowField mine, anyone;
+    mine.compute(*view.snapshot(), '1');
+    anyone.compute(*view.snapshot());
+    CHECK(mine.wallsAhead(0, 0, RIGHT) == FlowField::NO_TARGET);
+    CHECK(mine.distance(0, 0, RIGHT) == FlowField::UNREACHABLE);
+    CHECK(mine.distance(3, 0, RIGHT) == 0);
+    CHECK(anyone.distance(0, 0, RIGHT) == 0);
+}
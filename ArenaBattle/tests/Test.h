@@ -0,0 +1,43 @@
+// tests/Test.h
+#pragma once
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Minimal test registry for tanks_tests (make -f MakeFile test). TEST(name)
+// defines and registers a test; CHECK(cond) reports a failed condition and
+// carries on, REQUIRE(cond) also ends the test.
+
+namespace arena::test {
+
+struct Case {
+    const char*           name;
+    std::function<void()> run;
+};
+
+std::vector<Case>& registry();
+void fail(const char* file, int line, const std::string& what);
+
+struct Register {
+    Register(const char* name, std::function<void()> run) {
+        registry().push_back({name, std::move(run)});
+    }
+};
+
+} // namespace arena::test
+
+#define ARENA_TEST_CAT2(a, b) a##b
+#define ARENA_TEST_CAT(a, b)  ARENA_TEST_CAT2(a, b)
+
+#define TEST(name)                                                                  \
+    static void name();                                                             \
+    static const ::arena::test::Register ARENA_TEST_CAT(register_, name)(#name, name); \
+    static void name()
+
+#define CHECK(cond) \
+    do { if (!(cond)) ::arena::test::fail(__FILE__, __LINE__, #cond); } while (0)
+
+#define REQUIRE(cond) \
+    do { if (!(cond)) { ::arena::test::fail(__FILE__, __LINE__, #cond); return; } } while (0)
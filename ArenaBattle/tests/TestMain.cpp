@@ -0,0 +1,45 @@
+// tests/TestMain.cpp
+//
+// Runs every registered test: tanks_tests [--filter S]. Exit code 1 if any
+// check failed.
+
+#include "Test.h"
+
+#include <cstring>
+
+using namespace arena;
+
+namespace {
+std::size_t failures = 0;
+}
+
+std::vector<test::Case>& test::registry() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+void test::fail(const char* file, int line, const std::string& what) {
+    ++failures;
+    std::cerr << file << ':' << line << ": check failed: " << what << '\n';
+}
+
+int main(int argc, char** argv) {
+    std::string filter;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) filter = argv[++i];
+        else { std::cerr << "Usage: tanks_tests [--filter S]\n"; return 2; }
+    }
+
+    std::size_t ran = 0, failed = 0;
+    for (const auto& c : test::registry()) {
+        if (!filter.empty() && std::string(c.name).find(filter) == std::string::npos) continue;
+        const std::size_t before = failures;
+        c.run();
+        ++ran;
+        const bool ok = failures == before;
+        if (!ok) ++failed;
+        std::cout << (ok ? "ok   " : "FAIL ") << c.name << '\n';
+    }
+    std::cout << ran - failed << '/' << ran << " tests passed\n";
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,251 @@
+// tools/MapGen.cpp
+//
+// Seeded generator for map files in the format GameManager::readBoard reads.
+// Build with `make -f MakeFile mapgen`.
+//
+//   tanks_mapgen --rows R --cols C [--walls D] [--mines D]
+//                [--layout uniform|clustered] [--cluster-radius N]
+//                [--tanks1 N] [--tanks2 N] [--max-steps N] [--num-shells N]
+//                [--seed S] [--title T] [--out file]
+//
+// The same arguments always give the same file, on every platform: the
+// generator uses its own SplitMix64 stream instead of <random>'s
+// distributions. Rows are written as they are generated, so memory stays at
+// one row plus the tank list and (clustered layout) the wall discs, even for
+// boards of tens of thousands of rows and columns.
+
+#include "utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace arena;
+
+namespace {
+
+/// SplitMix64: tiny, fast, and identical everywhere.
+class SplitMix64 {
+public:
+    explicit SplitMix64(std::uint64_t seed) : state_(seed) {}
+
+    std::uint64_t next() {
+        std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    /// Uniform in [0, 1).
+    double unit() { return double(next() >> 11) * (1.0 / 9007199254740992.0); }
+    /// Uniform in [0, n), n > 0.
+    std::uint64_t below(std::uint64_t n) { return next() % n; }
+
+private:
+    std::uint64_t state_;
+};
+
+struct Options {
+    std::size_t rows = 0, cols = 0;
+    double      walls = 0.1, mines = 0.02;
+    bool        clustered = false;
+    std::size_t clusterRadius = 4;
+    std::size_t tanks1 = 1, tanks2 = 1;
+    std::size_t maxSteps = 1000, numShells = 16;
+    std::size_t seed = 1;
+    std::string title = "Generated map";
+    std::string outFile;
+};
+
+/// A filled wall disc of the clustered layout.
+struct Disc {
+    std::int64_t cx, cy, r;
+};
+
+//------------------------------------------------------------------------------
+bool parseArgs(int argc, char** argv, Options& o) {
+    auto number = [&](int& i, const char* key, std::size_t& out) {
+        return i + 1 < argc && parseKeyValue(std::string(key) + "=" + argv[++i], key, out);
+    };
+    auto fraction = [&](int& i, double& out) {
+        if (i + 1 >= argc) return false;
+        try {
+            out = std::stod(argv[++i]);
+        } catch (...) {
+            return false;
+        }
+        return out >= 0.0 && out <= 1.0;
+    };
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool ok = true;
+        if      (arg == "--rows")           ok = number(i, "rows", o.rows);
+        else if (arg == "--cols")           ok = number(i, "cols", o.cols);
+        else if (arg == "--walls")          ok = fraction(i, o.walls);
+        else if (arg == "--mines")          ok = fraction(i, o.mines);
+        else if (arg == "--cluster-radius") ok = number(i, "radius", o.clusterRadius);
+        else if (arg == "--tanks1")         ok = number(i, "tanks", o.tanks1);
+        else if (arg == "--tanks2")         ok = number(i, "tanks", o.tanks2);
+        else if (arg == "--max-steps")      ok = number(i, "steps", o.maxSteps);
+        else if (arg == "--num-shells")     ok = number(i, "shells", o.numShells);
+        else if (arg == "--seed")           ok = number(i, "seed", o.seed);
+        else if (arg == "--layout" && i + 1 < argc) {
+            std::string layout = argv[++i];
+            ok = layout == "uniform" || layout == "clustered";
+            o.clustered = layout == "clustered";
+        }
+        else if (arg == "--title" && i + 1 < argc) o.title   = argv[++i];
+        else if (arg == "--out" && i + 1 < argc)   o.outFile = argv[++i];
+        else ok = false;
+        if (!ok) {
+            std::cerr << "Invalid argument: " << arg << "\n";
+            return false;
+        }
+    }
+    if (o.rows == 0 || o.cols == 0) {
+        std::cerr << "--rows and --cols are required and must be positive\n";
+        return false;
+    }
+    if (o.walls + o.mines > 1.0) {
+        std::cerr << "Wall and mine densities add up to more than 1\n";
+        return false;
+    }
+    if (o.tanks1 + o.tanks2 > o.rows * o.cols / 2) {
+        std::cerr << "Too many tanks for a " << o.rows << "x" << o.cols << " board\n";
+        return false;
+    }
+    if (o.title.empty() || o.title.find_first_not_of(".#@12") == std::string::npos) {
+        std::cerr << "The title must not look like a grid row\n";
+        return false;
+    }
+    return true;
+}
+
+/// Tank cells as (flat index, '1' or '2'), sorted by index.
+std::vector<std::pair<std::uint64_t, char>> placeTanks(const Options& o, SplitMix64& rng) {
+    const std::uint64_t cells = std::uint64_t(o.rows) * o.cols;
+    std::unordered_set<std::uint64_t> taken;
+    std::vector<std::pair<std::uint64_t, char>> tanks;
+    tanks.reserve(o.tanks1 + o.tanks2);
+    for (char player : {'1', '2'}) {
+        std::size_t want = player == '1' ? o.tanks1 : o.tanks2;
+        while (want > 0) {
+            std::uint64_t idx = rng.below(cells);
+            if (!taken.insert(idx).second) continue;
+            tanks.emplace_back(idx, player);
+            --want;
+        }
+    }
+    std::sort(tanks.begin(), tanks.end());
+    return tanks;
+}
+
+/// Wall discs covering roughly `walls` of the board, sorted by first row
+/// touched. Randomly placed discs overlap, so a fraction d needs about
+/// -ln(1-d) board areas' worth of discs.
+std::vector<Disc> placeDiscs(const Options& o, SplitMix64& rng) {
+    const double r     = double(std::max<std::size_t>(o.clusterRadius, 1));
+    const double area  = 3.14159265358979 * r * r;
+    const double cover = -std::log(1.0 - std::min(o.walls, 0.99));
+    const auto   count = std::uint64_t(cover * double(o.rows) * double(o.cols) / area);
+    std::vector<Disc> discs;
+    discs.reserve(count);
+    for (std::uint64_t i = 0; i < count; ++i) {
+        Disc d;
+        d.cx = std::int64_t(rng.below(o.cols));
+        d.cy = std::int64_t(rng.below(o.rows));
+        // radius varies between r/2 and 3r/2 for less regular blobs
+        d.r  = std::max<std::int64_t>(1, std::int64_t(r * (0.5 + rng.unit())));
+        discs.push_back(d);
+    }
+    std::sort(discs.begin(), discs.end(), [](const Disc& a, const Disc& b) {
+        return a.cy - a.r < b.cy - b.r;
+    });
+    return discs;
+}
+
+//------------------------------------------------------------------------------
+void generate(const Options& o, std::ostream& out) {
+    // independent streams so changing one density does not move the tanks
+    SplitMix64 tankRng(o.seed * 3 + 1), wallRng(o.seed * 3 + 2), cellRng(o.seed * 3 + 3);
+
+    const auto tanks = placeTanks(o, tankRng);
+    std::vector<Disc> discs;
+    if (o.clustered) discs = placeDiscs(o, wallRng);
+
+    out << o.title << "\n"
+        << "MaxSteps = "  << o.maxSteps  << "\n"
+        << "NumShells = " << o.numShells << "\n"
+        << "Rows = "      << o.rows      << "\n"
+        << "Cols = "      << o.cols      << "\n";
+
+    std::string line(o.cols, '.');
+    std::vector<Disc> active;
+    std::size_t nextDisc = 0, nextTank = 0;
+    for (std::size_t y = 0; y < o.rows; ++y) {
+        const auto iy = std::int64_t(y);
+        if (o.clustered) {
+            std::fill(line.begin(), line.end(), '.');
+            while (nextDisc < discs.size() && discs[nextDisc].cy - discs[nextDisc].r <= iy)
+                active.push_back(discs[nextDisc++]);
+            active.erase(std::remove_if(active.begin(), active.end(),
+                                        [&](const Disc& d) { return d.cy + d.r < iy; }),
+                         active.end());
+            for (const Disc& d : active) {
+                std::int64_t dy   = iy - d.cy;
+                std::int64_t half = std::int64_t(std::sqrt(double(d.r * d.r - dy * dy)));
+                std::int64_t x0 = std::max<std::int64_t>(0, d.cx - half);
+                std::int64_t x1 = std::min<std::int64_t>(std::int64_t(o.cols) - 1, d.cx + half);
+                for (std::int64_t x = x0; x <= x1; ++x) line[std::size_t(x)] = '#';
+            }
+            const double mineShare = o.walls < 1.0 ? o.mines / (1.0 - o.walls) : 0.0;
+            for (char& c : line)
+                if (c == '.' && cellRng.unit() < mineShare) c = '@';
+        } else {
+            for (char& c : line) {
+                double p = cellRng.unit();
+                c = p < o.walls ? '#' : p < o.walls + o.mines ? '@' : '.';
+            }
+        }
+
+        const std::uint64_t rowEnd = std::uint64_t(y + 1) * o.cols;
+        for (; nextTank < tanks.size() && tanks[nextTank].first < rowEnd; ++nextTank)
+            line[tanks[nextTank].first % o.cols] = tanks[nextTank].second;
+
+        out << line << '\n';
+    }
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv) {
+    Options o;
+    if (!parseArgs(argc, argv, o)) {
+        std::cerr << "Usage: tanks_mapgen --rows R --cols C [--walls D] [--mines D]\n"
+                  << "                    [--layout uniform|clustered] [--cluster-radius N]\n"
+                  << "                    [--tanks1 N] [--tanks2 N] [--max-steps N] [--num-shells N]\n"
+                  << "                    [--seed S] [--title T] [--out file]\n";
+        return 1;
+    }
+
+    if (o.outFile.empty()) {
+        generate(o, std::cout);
+        return std::cout ? 0 : 1;
+    }
+    std::ofstream out(o.outFile);
+    if (!out) {
+        std::cerr << "Cannot open output file: " << o.outFile << "\n";
+        return 1;
+    }
+    generate(o, out);
+    if (!out) {
+        std::cerr << "Failed writing " << o.outFile << "\n";
+        return 1;
+    }
+    return 0;
+}